@@ -21,6 +21,9 @@ public class DeltacastAdapter {
     //[DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)] private static extern void StopCapture2();
     [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)] private static extern int GetFrame(int index, IntPtr dst, int maxSize);
     //[DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)] private static extern int GetFrame2(IntPtr dst, int maxSize);
+    [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)] private static extern int GetFrameIfNewer(int index, IntPtr dst, int maxSize, ulong lastSeen, out ulong seqOut);
+    [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)] private static extern int AcquireFrame(int index, out IntPtr data, out int size, out ulong seq);
+    [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)] private static extern void ReleaseFrame(int index, ulong seq);
 
     [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
     private static extern void SetBurnInFrameNumber(int index, int enabled);
@@ -28,14 +31,52 @@ public class DeltacastAdapter {
     [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
     private static extern ulong GetNativeFrameCounter(int index);
 
-    public Texture2D tex;
+    [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+    private static extern void SetOutputFormat(int index, uint format);
+
+    [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+    private static extern void SetColorMatrix(int index, uint matrix);
+
+    [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+    private static extern void SetConversionMode(int index, uint mode);
+
+    [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+    private static extern void SetLatencyMode(int index, uint mode);
+
+    [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+    private static extern void GetFrameAge(int index, out double lastMs, out double averageMs, out ulong drainedSlots);
+
+    // Mirrors StreamStats in unityDeltacast.h.
+    [StructLayout(LayoutKind.Sequential)]
+    public struct StreamStats {
+        public ulong capturedFrames;
+        public ulong publishedFrames;
+        public ulong consumedFrames;
+        public uint boardSlotsCount;
+        public ulong boardSlotsDropped;
+        public double conversionP50Ms;
+        public double conversionP99Ms;
+        public double conversionMaxMs;
+        public double publishToFetchMs;
+        public int recorderBacklog;
+        public ulong recorderGapFills;
+        public double captureThreadCpuMs;
+        public double conversionThreadCpuMs;
+    }
+
+    [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+    private static extern int GetStreamStats(int index, out StreamStats stats);
 
-    private byte[] buffer;
+    [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+    private static extern int GetLatencyStats(int index, out double publishP50, out double publishP99, out double fetchP50, out double fetchP99);
 
-    private GCHandle handle;
+    [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+    private static extern void SetTracing(int enabled);
 
-    private IntPtr bufferPtr;
+    [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+    private static extern int DumpTrace([MarshalAs(UnmanagedType.LPStr)] string path);
 
+    public Texture2D tex;
 
     public bool initialized = false;
 
@@ -44,6 +85,9 @@ public class DeltacastAdapter {
 
     private int curH;
 
+    // Frame number of the last uploaded frame; 0 forces the next upload.
+    private ulong lastFrameSeq = 0;
+
     public uint width;
     public uint height;
     public int boardID;
@@ -57,6 +101,8 @@ public class DeltacastAdapter {
     public VHD_CLOCKDIVISOR clock_divisor;
     public VHD_INTERFACE video_interface;
     public bool fieldMerge;
+    // Unmerged 1080i50 Level-B fields: motion-adaptive instead of bob deinterlacing.
+    public bool motionAdaptive;
     public VHD_BUFFERPACKING buffer_packing;
     public VIDEOINPUT dvSdiAuto;
 
@@ -65,6 +111,27 @@ public class DeltacastAdapter {
 
     public bool burnInFrameNumber = false;
 
+    // Pixel format the plugin publishes (UNITYDELTACAST_OUTPUT_*).
+    //   BGRA32  : converted on the CPU, 10-bit input dithered
+    //   RGBA64  : converted on the CPU, keeps 10-bit input precision
+    //   RawUYVY : unconverted 4:2:2, uploaded as a width/2 RGBA32 texture (U,Y0,V,Y1 per texel,
+    //             top row first) for a material that converts to RGB; YUV422_8 packing only
+    public enum PublishFormat : uint { BGRA32 = 0, RGBA64 = 1, RawUYVY = 2 }
+    public PublishFormat publishFormat = PublishFormat.BGRA32;
+
+    // YCbCr -> RGB matrix of the CPU conversion (UNITYDELTACAST_COLOR_MATRIX_*).
+    // Auto follows the signal: DV colorimetry, else BT.601 for SD and BT.709 for HD.
+    public enum ColorMatrix : uint { Auto = 0, BT601Limited, BT601Full, BT709Limited, BT709Full, BT2020Limited, BT2020Full }
+    public ColorMatrix colorMatrix = ColorMatrix.Auto;
+
+    // Convert only the frames this component actually reads (UNITYDELTACAST_CONVERSION_ON_DEMAND):
+    // while it is disabled the plugin keeps the signal locked but skips the conversion.
+    public bool convertOnDemand = false;
+
+    // Drain the board queue and show only the newest slot (UNITYDELTACAST_LATENCY_NEWEST);
+    // applied when the capture starts.
+    public bool lowLatency = false;
+
     private bool lastBurnInFrameNumber = false;
 
     public void Init() {
@@ -77,29 +144,20 @@ public class DeltacastAdapter {
 
         //string msg = Marshal.PtrToStringAnsi(GetMessage());
 
+        lastFrameSeq = 0;
         curW = Math.Max(1, (int)width);
         curH = Math.Max(1, (int)height);
         if(!(stereoConfig.Equals(StereoConfig.SBSFullWidthLeftOnly) || stereoConfig.Equals(StereoConfig.SBSFullWidthRightOnly))) {
-            tex = new Texture2D(curW, curH, TextureFormat.BGRA32, false);
-            buffer = new byte[curW * curH * 4]; // BGRA target
+            tex = new Texture2D(TexWidth(curW), curH, TexFormat(), false);
         }
         else {
             tex = new Texture2D(curW * 2, curH, TextureFormat.BGRA32, false);
-            buffer = new byte[curW * curH * 4 * 2]; // BGRA target
-        }
-
-        try {
-            handle = GCHandle.Alloc(buffer, GCHandleType.Pinned);
-            bufferPtr = handle.AddrOfPinnedObject();
-        }
-        catch {
-            // make sure to release anything partially allocated
-            if(handle.IsAllocated) {
-                handle.Free();
-            }
-            throw;
         }
 
+        SetOutputFormat(captureIndex, (uint)publishFormat);
+        SetColorMatrix(captureIndex, (uint)colorMatrix);
+        SetConversionMode(captureIndex, convertOnDemand ? 1u : 0u);
+        SetLatencyMode(captureIndex, lowLatency ? 1u : 0u);
 
         SetBurnInFrameNumber(captureIndex, burnInFrameNumber ? 1 : 0);
         lastBurnInFrameNumber = burnInFrameNumber;
@@ -116,7 +174,7 @@ public class DeltacastAdapter {
                 dvSdiAutoAsChar = 'A';
             }
             uint progressiveuint = progressive ? (uint)1 : (uint)0;
-            uint fieldMergeuint = fieldMerge ? (uint)1 : (uint)0;
+            uint fieldMergeuint = fieldMerge ? (uint)1 : motionAdaptive ? (uint)2 : (uint)0;
 
             StartCapture(captureIndex, boardID, streamID, 2, dvSdiAutoAsChar, width, height, progressiveuint, framerate, cable_color_space, cable_sampling, video_standard, clock_divisor, video_interface, fieldMergeuint, buffer_packing); // board 0, stream RX0, bufferdepth
 
@@ -139,18 +197,29 @@ public class DeltacastAdapter {
             lastBurnInFrameNumber = burnInFrameNumber;
         }
 
-        // If native resolution changed, rebuild texture & buffer
+        // If native resolution changed, rebuild texture
         int w = GetWidth(captureIndex);
         int h = GetHeight(captureIndex);
         if(w > 0 && h > 0 && (w != curW || h != curH)) {
             RecreateResources(w, h);
         }
-        int bytes;
-        bytes = GetFrame(captureIndex, bufferPtr, buffer.Length);
-        //Debug.Log(bytes);
-        if(bytes > 0) {
-            tex.LoadRawTextureData(bufferPtr, bytes);
-            tex.Apply(false);
+        // Upload straight from the plugin's frame buffer; it stays untouched until released.
+        // Render rate usually exceeds the capture rate: skip frames that were already uploaded.
+        int bytes = 0;
+        if(GetNativeFrameCounter(captureIndex) > lastFrameSeq
+            && AcquireFrame(captureIndex, out IntPtr data, out int size, out ulong seq) != 0) {
+            try {
+                // A frame published at a new resolution can arrive before GetWidth/GetHeight report it.
+                if(seq > lastFrameSeq && size == tex.width * tex.height * BytesPerTexel()) {
+                    tex.LoadRawTextureData(data, size);
+                    tex.Apply(false);
+                    lastFrameSeq = seq;
+                    bytes = size;
+                }
+            }
+            finally {
+                ReleaseFrame(captureIndex, seq);
+            }
         }
 
 
@@ -160,32 +229,72 @@ public class DeltacastAdapter {
     }
 
     void RecreateResources(int w, int h) {
-        // stop using old pinned memory during resize
-        if(handle.IsAllocated) {
-            handle.Free();
-        }
-
         curW = w;
         curH = h;
-
-        // reallocate managed buffer & pin again
-        buffer = new byte[curW * curH * 4];
-        handle = GCHandle.Alloc(buffer, GCHandleType.Pinned);
-        bufferPtr = handle.AddrOfPinnedObject();
+        lastFrameSeq = 0;
 
         if(tex == null) {
-            tex = new Texture2D(curW, curH, TextureFormat.BGRA32, false);
+            tex = new Texture2D(TexWidth(curW), curH, TexFormat(), false);
         }
         else {
-            tex.Reinitialize(curW, curH, TextureFormat.BGRA32, false);
+            tex.Reinitialize(TexWidth(curW), curH, TexFormat(), false);
             tex.Apply(false, false);
 
         }
     }
+    // The stereo capture always publishes BGRA32.
+    PublishFormat EffectivePublishFormat() {
+        bool stereo = stereoConfig.Equals(StereoConfig.SBSFullWidthLeftOnly) || stereoConfig.Equals(StereoConfig.SBSFullWidthRightOnly);
+        return stereo ? PublishFormat.BGRA32 : publishFormat;
+    }
+
+    TextureFormat TexFormat() {
+        switch(EffectivePublishFormat()) {
+            case PublishFormat.RGBA64: return TextureFormat.RGBA64;
+            case PublishFormat.RawUYVY: return TextureFormat.RGBA32;
+            default: return TextureFormat.BGRA32;
+        }
+    }
+
+    // One RawUYVY texel holds two pixels.
+    int TexWidth(int w) {
+        return EffectivePublishFormat() == PublishFormat.RawUYVY ? Math.Max(1, w / 2) : w;
+    }
+
+    int BytesPerTexel() {
+        return EffectivePublishFormat() == PublishFormat.RGBA64 ? 8 : 4;
+    }
+
     public ulong GetNativeFrameNumber() {
         return GetNativeFrameCounter(captureIndex);
     }
 
+    // Capture-to-publish age of the latest frame and its running average, in ms.
+    public Vector2 GetFrameAgeMs() {
+        GetFrameAge(captureIndex, out double lastMs, out double averageMs, out ulong drainedSlots);
+        return new Vector2((float)lastMs, (float)averageMs);
+    }
+
+    // Capture-to-fetch latency over the last 256 frames: x = p50, y = p99, in ms.
+    public Vector2 GetFetchLatencyMs() {
+        GetLatencyStats(captureIndex, out double publishP50, out double publishP99, out double fetchP50, out double fetchP99);
+        return new Vector2((float)fetchP50, (float)fetchP99);
+    }
+
+    public StreamStats GetStats() {
+        GetStreamStats(captureIndex, out StreamStats stats);
+        return stats;
+    }
+
+    // Pipeline trace of all streams; open the dump in chrome://tracing or ui.perfetto.dev.
+    public static void SetTracingEnabled(bool enabled) {
+        SetTracing(enabled ? 1 : 0);
+    }
+
+    public static int WriteTrace(string path) {
+        return DumpTrace(path);
+    }
+
     public void Stop() {
         try {
             if(tex != null) {
@@ -196,11 +305,6 @@ public class DeltacastAdapter {
             
         }
         finally {
-            if(handle.IsAllocated) {
-                handle.Free();
-                bufferPtr = IntPtr.Zero;   // invalidate the pointer
-                buffer = null;           // let GC reclaim the array
-            }
             initialized = false;
         }
     }
@@ -0,0 +1,128 @@
+#include "conversion_pool.hpp"
+
+#include <algorithm>
+
+static int DefaultThreadCount()
+{
+    const unsigned hw = std::thread::hardware_concurrency();
+    return int(std::clamp<unsigned>(hw, 1u, 8u));
+}
+
+ConversionPool& ConversionPool::Instance()
+{
+    static ConversionPool pool;
+    return pool;
+}
+
+ConversionPool::ConversionPool()
+{
+    const int n = DefaultThreadCount();
+    participants.store(n, std::memory_order_relaxed);
+    StartWorkers(n - 1);
+}
+
+ConversionPool::~ConversionPool()
+{
+    StopWorkers();
+}
+
+void ConversionPool::SetThreadCount(int threads)
+{
+    if (threads <= 0) threads = DefaultThreadCount();
+    threads = std::min(threads, 64);
+
+    std::lock_guard<std::mutex> cfg(configMutex);
+    if (threads == participants.load(std::memory_order_relaxed)) return;
+
+    // Batches that are in flight keep running: their submitters execute every
+    // task the departing workers did not claim.
+    StopWorkers();
+    participants.store(threads, std::memory_order_relaxed);
+    StartWorkers(threads - 1);
+}
+
+void ConversionPool::StartWorkers(int workerCount)
+{
+    {
+        std::lock_guard<std::mutex> lk(mutex);
+        stop = false;
+    }
+    for (int i = 0; i < workerCount; ++i) {
+        workers.emplace_back(&ConversionPool::WorkerLoop, this);
+    }
+}
+
+void ConversionPool::StopWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lk(mutex);
+        stop = true;
+    }
+    workAvailable.notify_all();
+    for (auto& t : workers) {
+        if (t.joinable()) t.join();
+    }
+    workers.clear();
+}
+
+void ConversionPool::Execute(Batch& batch)
+{
+    for (;;) {
+        const int i = batch.next.fetch_add(1, std::memory_order_relaxed);
+        if (i >= batch.count) break;
+        batch.invoke(batch.ctx, i);
+        batch.remaining.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+void ConversionPool::WorkerLoop()
+{
+    std::unique_lock<std::mutex> lk(mutex);
+    for (;;) {
+        workAvailable.wait(lk, [this] { return stop || !batches.empty(); });
+        if (stop) return;
+
+        Batch* batch = batches.front();
+        ++batch->users;
+        lk.unlock();
+
+        Execute(*batch);
+
+        lk.lock();
+        // Every task has been claimed: retire the batch so idle workers don't pick it again.
+        if (!batches.empty() && batches.front() == batch) batches.pop_front();
+        if (--batch->users == 0) batchReleased.notify_all();
+    }
+}
+
+void ConversionPool::Run(int count, Invoke invoke, void* ctx)
+{
+    if (count <= 0) return;
+    if (count == 1 || participants.load(std::memory_order_relaxed) <= 1) {
+        for (int i = 0; i < count; ++i) invoke(ctx, i);
+        return;
+    }
+
+    Batch batch;
+    batch.invoke = invoke;
+    batch.ctx = ctx;
+    batch.count = count;
+    batch.remaining.store(count, std::memory_order_relaxed);
+
+    {
+        std::lock_guard<std::mutex> lk(mutex);
+        batches.push_back(&batch);
+    }
+    workAvailable.notify_all();
+
+    Execute(batch);
+
+    // The batch lives on this stack frame: unlink it and wait until no worker still
+    // references it and every claimed task has completed.
+    std::unique_lock<std::mutex> lk(mutex);
+    auto it = std::find(batches.begin(), batches.end(), &batch);
+    if (it != batches.end()) batches.erase(it);
+    batchReleased.wait(lk, [&batch] {
+        return batch.users == 0 && batch.remaining.load(std::memory_order_acquire) == 0;
+    });
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Rows handed to one conversion pool task; keeps bands large enough that the
+// scheduling overhead stays negligible next to the conversion itself.
+constexpr int kMinRowsPerBand = 32;
+
+// Process-wide worker pool shared by all capture threads.
+//
+// A caller submits `count` independent tasks and takes part in executing them
+// itself, so a pool with N participants runs N-1 worker threads and a pool of
+// size 1 degenerates to a plain serial loop. Several capture threads may submit
+// at the same time; their batches are served in arrival order.
+class ConversionPool {
+public:
+    // Wall-clock time of a ParallelBands call and the sum of the time spent in
+    // each band, i.e. what the same work would have cost on a single thread.
+    struct Timing {
+        long long wallNs = 0;
+        long long workNs = 0;
+    };
+
+    static ConversionPool& Instance();
+
+    ~ConversionPool();
+
+    // Number of threads (caller included) that execute a batch. 0 selects a
+    // default derived from std::thread::hardware_concurrency().
+    void SetThreadCount(int threads);
+    int ThreadCount() const { return participants.load(std::memory_order_relaxed); }
+
+    // Runs fn(i) for i in [0, count) and returns once every call has finished.
+    template <class F>
+    void ParallelFor(int count, F&& fn)
+    {
+        using Fn = typename std::remove_reference<F>::type;
+        Run(count, [](void* ctx, int i) { (*static_cast<Fn*>(ctx))(i); }, &fn);
+    }
+
+    // Splits rows [0, rows) into horizontal bands of at least minRows rows and
+    // runs fn(y0, y1) for each band in parallel.
+    template <class F>
+    Timing ParallelBands(int rows, int minRows, F&& fn)
+    {
+        Timing timing;
+        if (rows <= 0) return timing;
+        if (minRows < 1) minRows = 1;
+
+        int bands = ThreadCount();
+        if (bands > rows / minRows) bands = rows / minRows;
+        if (bands < 1) bands = 1;
+
+        std::atomic<long long> workNs{ 0 };
+        const auto t0 = std::chrono::steady_clock::now();
+        ParallelFor(bands, [&](int band) {
+            const auto b0 = std::chrono::steady_clock::now();
+            const int y0 = int((long long)rows * band / bands);
+            const int y1 = int((long long)rows * (band + 1) / bands);
+            fn(y0, y1);
+            workNs.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - b0).count(), std::memory_order_relaxed);
+        });
+        timing.wallNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - t0).count();
+        timing.workNs = workNs.load(std::memory_order_relaxed);
+        return timing;
+    }
+
+private:
+    using Invoke = void (*)(void* ctx, int index);
+
+    struct Batch {
+        Invoke invoke = nullptr;
+        void* ctx = nullptr;
+        int count = 0;
+        std::atomic<int> next{ 0 };
+        std::atomic<int> remaining{ 0 };
+        int users = 0;          // workers currently holding this batch (guarded by mutex)
+    };
+
+    ConversionPool();
+
+    void Run(int count, Invoke invoke, void* ctx);
+    void Execute(Batch& batch);
+    void WorkerLoop();
+    void StartWorkers(int workerCount);
+    void StopWorkers();
+
+    std::mutex configMutex;                 // serializes SetThreadCount
+    std::atomic<int> participants{ 1 };
+
+    std::mutex mutex;                       // guards batches, users, stop
+    std::condition_variable workAvailable;
+    std::condition_variable batchReleased;
+    std::deque<Batch*> batches;
+    std::vector<std::thread> workers;
+    bool stop = false;
+};
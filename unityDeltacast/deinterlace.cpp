@@ -0,0 +1,544 @@
+#include "deinterlace.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define UNITYDELTACAST_DEINTERLACE_SSE2 1
+#elif defined(UNITYDELTACAST_ARCH_NEON)
+#  include <arm_neon.h>
+#endif
+
+namespace {
+
+// Where the lines of one field sit in the slot buffer.
+struct FieldLayout {
+    int sourceParity = 0;   // frame row of field line 0
+    int fieldRows = 0;
+    size_t rowBytes = 0;    // packed bytes of one line
+    size_t srcPitch = 0;
+};
+
+bool GetFieldLayout(SourcePacking packing, size_t totalBytes, int W, int H, bool evenField, FieldLayout& l)
+{
+    if (W <= 0 || H <= 0 || (W & 1) != 0) return false;
+
+    l.sourceParity = evenField ? 1 : 0;
+    l.fieldRows = (H - l.sourceParity + 1) / 2;
+    if (l.fieldRows <= 0) return false;
+
+    l.rowBytes = PackedRowBytes(packing, W);
+    const size_t minimumFieldBytes = l.rowBytes * size_t(l.fieldRows);
+    if (totalBytes < minimumFieldBytes) return false;
+
+    l.srcPitch = l.rowBytes;
+    const size_t minimumFrameBytes = l.rowBytes * size_t(H);
+    if (totalBytes < minimumFrameBytes && totalBytes % size_t(l.fieldRows) == 0) {
+        const size_t candidatePitch = totalBytes / size_t(l.fieldRows);
+        if (candidatePitch >= l.rowBytes) l.srcPitch = candidatePitch;
+    }
+
+    return (size_t(l.fieldRows - 1) * l.srcPitch) + l.rowBytes <= totalBytes;
+}
+
+// out = (a + b) >> 1 per byte, without widening: (a & b) + ((a ^ b) >> 1).
+void AverageRowsFloor8(const uint8_t* a, const uint8_t* b, uint8_t* out, size_t bytes)
+{
+    size_t i = 0;
+#if defined(UNITYDELTACAST_DEINTERLACE_SSE2)
+    // pavgb rounds up; subtract the carry it added when a + b is odd.
+    const __m128i one = _mm_set1_epi8(1);
+    for (; i + 16 <= bytes; i += 16) {
+        const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        const __m128i odd = _mm_and_si128(_mm_xor_si128(va, vb), one);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_sub_epi8(_mm_avg_epu8(va, vb), odd));
+    }
+#elif defined(UNITYDELTACAST_ARCH_NEON)
+    for (; i + 16 <= bytes; i += 16) {
+        vst1q_u8(out + i, vhaddq_u8(vld1q_u8(a + i), vld1q_u8(b + i)));
+    }
+#endif
+    for (; i < bytes; ++i) {
+        out[i] = uint8_t((a[i] & b[i]) + ((a[i] ^ b[i]) >> 1));
+    }
+}
+
+void AverageRowsFloor16(const uint16_t* a, const uint16_t* b, uint16_t* out, size_t count)
+{
+    size_t i = 0;
+#if defined(UNITYDELTACAST_DEINTERLACE_SSE2)
+    const __m128i one = _mm_set1_epi16(1);
+    for (; i + 8 <= count; i += 8) {
+        const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        const __m128i odd = _mm_and_si128(_mm_xor_si128(va, vb), one);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_sub_epi16(_mm_avg_epu16(va, vb), odd));
+    }
+#elif defined(UNITYDELTACAST_ARCH_NEON)
+    for (; i + 8 <= count; i += 8) {
+        vst1q_u16(out + i, vhaddq_u16(vld1q_u16(a + i), vld1q_u16(b + i)));
+    }
+#endif
+    for (; i < count; ++i) {
+        out[i] = uint16_t((a[i] & b[i]) + ((a[i] ^ b[i]) >> 1));
+    }
+}
+
+void AverageRows(bool sixteenBit, const uint8_t* a, const uint8_t* b, uint8_t* out, size_t bytes)
+{
+    if (sixteenBit) {
+        AverageRowsFloor16(reinterpret_cast<const uint16_t*>(a), reinterpret_cast<const uint16_t*>(b),
+                           reinterpret_cast<uint16_t*>(out), bytes / 2);
+    }
+    else {
+        AverageRowsFloor8(a, b, out, bytes);
+    }
+}
+
+// Motion-adaptive line: clamp(bob, prevField - d, prevField + d) with
+// d = max(|up - up2|, |down - down2|) per byte, where up/down are the current
+// field's lines around the missing one and up2/down2 the same lines two fields ago.
+void MotionAdaptiveRow_Scalar(const uint8_t* up, const uint8_t* down, const uint8_t* mid1,
+                              const uint8_t* up2, const uint8_t* down2, uint8_t* out, size_t bytes)
+{
+    auto absDiff = [](int a, int b) { return a > b ? a - b : b - a; };
+    for (size_t i = 0; i < bytes; ++i) {
+        const int spatial = (up[i] + down[i]) >> 1;
+        const int d = std::max(absDiff(up[i], up2[i]), absDiff(down[i], down2[i]));
+        const int lo = std::max(int(mid1[i]) - d, 0);
+        const int hi = std::min(int(mid1[i]) + d, 255);
+        out[i] = uint8_t(std::min(std::max(spatial, lo), hi));
+    }
+}
+
+void MotionAdaptiveRow(const uint8_t* up, const uint8_t* down, const uint8_t* mid1,
+                       const uint8_t* up2, const uint8_t* down2, uint8_t* out, size_t bytes)
+{
+    size_t i = 0;
+#if defined(UNITYDELTACAST_DEINTERLACE_SSE2)
+    // All unsigned saturating byte ops, 16 components per iteration.
+    const __m128i one = _mm_set1_epi8(1);
+    for (; i + 16 <= bytes; i += 16) {
+        const __m128i u = _mm_loadu_si128(reinterpret_cast<const __m128i*>(up + i));
+        const __m128i dn = _mm_loadu_si128(reinterpret_cast<const __m128i*>(down + i));
+        const __m128i m = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mid1 + i));
+        const __m128i u2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(up2 + i));
+        const __m128i d2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(down2 + i));
+
+        const __m128i spatial = _mm_sub_epi8(_mm_avg_epu8(u, dn), _mm_and_si128(_mm_xor_si128(u, dn), one));
+        const __m128i du = _mm_or_si128(_mm_subs_epu8(u, u2), _mm_subs_epu8(u2, u));
+        const __m128i dd = _mm_or_si128(_mm_subs_epu8(dn, d2), _mm_subs_epu8(d2, dn));
+        const __m128i d = _mm_max_epu8(du, dd);
+        const __m128i lo = _mm_subs_epu8(m, d);
+        const __m128i hi = _mm_adds_epu8(m, d);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_min_epu8(_mm_max_epu8(spatial, lo), hi));
+    }
+#elif defined(UNITYDELTACAST_ARCH_NEON)
+    for (; i + 16 <= bytes; i += 16) {
+        const uint8x16_t u = vld1q_u8(up + i);
+        const uint8x16_t dn = vld1q_u8(down + i);
+        const uint8x16_t m = vld1q_u8(mid1 + i);
+        const uint8x16_t d = vmaxq_u8(vabdq_u8(u, vld1q_u8(up2 + i)), vabdq_u8(dn, vld1q_u8(down2 + i)));
+        const uint8x16_t spatial = vhaddq_u8(u, dn);
+        vst1q_u8(out + i, vminq_u8(vmaxq_u8(spatial, vqsubq_u8(m, d)), vqaddq_u8(m, d)));
+    }
+#endif
+    if (i < bytes) {
+        MotionAdaptiveRow_Scalar(up + i, down + i, mid1 + i, up2 + i, down2 + i, out + i, bytes - i);
+    }
+}
+
+// The previous two-pass bob: convert the field lines, then interpolate the
+// missing lines from the finished frame. Kept as the benchmark's baseline and
+// reference output.
+bool Convert422_Field_Bob_TwoPass(SourcePacking packing, OutputFormat format, bool raw,
+                                  const uint8_t* src, size_t totalBytes, uint8_t* dst, int dstPitch,
+                                  int W, int H, bool evenField, bool flipY, ConversionPool::Timing& timing)
+{
+    FieldLayout l;
+    if (!src || !dst || !GetFieldLayout(packing, totalBytes, W, H, evenField, l)) return false;
+
+    ConversionPool& pool = ConversionPool::Instance();
+
+    const ConversionPool::Timing fieldPass = pool.ParallelBands(l.fieldRows, kMinRowsPerBand, [&](int f0, int f1) {
+        for (int fieldY = f0; fieldY < f1; ++fieldY) {
+            const int sourceFrameY = fieldY * 2 + l.sourceParity;
+            const int outputY = flipY ? (H - 1 - sourceFrameY) : sourceFrameY;
+            if (raw) {
+                std::memcpy(dst + size_t(outputY) * dstPitch, src + size_t(fieldY) * l.srcPitch, l.rowBytes);
+                continue;
+            }
+            Convert422_Row(packing, format, src + size_t(fieldY) * l.srcPitch,
+                           dst + size_t(outputY) * dstPitch, W, outputY);
+        }
+    });
+
+    const int outputFieldParity = flipY ? ((H - 1 - l.sourceParity) & 1) : l.sourceParity;
+    const int rowBytesOut = raw ? int(l.rowBytes) : W * OutputBytesPerPixel(format);
+
+    const ConversionPool::Timing interpolationPass = pool.ParallelBands(H, kMinRowsPerBand, [&](int y0, int y1) {
+        for (int y = y0; y < y1; ++y) {
+            if ((y & 1) == outputFieldParity) continue;
+
+            int upY = y - 1;
+            int downY = y + 1;
+            if (upY < 0) upY = downY;
+            if (downY >= H) downY = upY;
+
+            uint8_t* out = dst + size_t(y) * dstPitch;
+            const uint8_t* up = dst + size_t(upY) * dstPitch;
+            const uint8_t* down = dst + size_t(downY) * dstPitch;
+
+            if (upY == downY) {
+                std::memcpy(out, up, rowBytesOut);
+            }
+            else if (!raw && format == OutputFormat::RGBA16) {
+                uint16_t* out16 = reinterpret_cast<uint16_t*>(out);
+                const uint16_t* up16 = reinterpret_cast<const uint16_t*>(up);
+                const uint16_t* down16 = reinterpret_cast<const uint16_t*>(down);
+                for (int i = 0; i < rowBytesOut / 2; ++i) {
+                    out16[i] = uint16_t((int(up16[i]) + int(down16[i])) >> 1);
+                }
+            }
+            else {
+                for (int i = 0; i < rowBytesOut; ++i) {
+                    out[i] = uint8_t((int(up[i]) + int(down[i])) >> 1);
+                }
+            }
+        }
+    });
+
+    timing.wallNs += fieldPass.wallNs + interpolationPass.wallNs;
+    timing.workNs += fieldPass.workNs + interpolationPass.workNs;
+    return true;
+}
+
+} // namespace
+
+bool Convert422_Field_Bob(SourcePacking packing,
+                          OutputFormat format,
+                          ColorMatrix matrix,
+                          bool raw,
+                          const uint8_t* src,
+                          size_t totalBytes,
+                          uint8_t* dst,
+                          int dstPitch,
+                          int W,
+                          int H,
+                          bool evenField,
+                          bool flipY,
+                          ConversionPool::Timing& timing)
+{
+    FieldLayout l;
+    if (!src || !dst || !GetFieldLayout(packing, totalBytes, W, H, evenField, l)) return false;
+
+    const size_t rowBytesOut = raw ? l.rowBytes : size_t(W) * OutputBytesPerPixel(format);
+    const bool sixteenBit = !raw && format == OutputFormat::RGBA16;
+
+    // Averaging is symmetric, so the missing lines are found in frame rows and
+    // only the final row address is flipped.
+    auto outputRow = [&](int frameY) { return flipY ? (H - 1 - frameY) : frameY; };
+    auto rowPtr = [&](int frameY) { return dst + size_t(outputRow(frameY)) * dstPitch; };
+    const Convert422RowKernel convert = GetConvert422RowKernel(packing, format, matrix);
+    auto convertField = [&](int fieldY, uint8_t* out) {
+        const uint8_t* s = src + size_t(fieldY) * l.srcPitch;
+        if (raw) {
+            std::memcpy(out, s, l.rowBytes);
+        }
+        else {
+            convert(s, out, W, outputRow(fieldY * 2 + l.sourceParity));
+        }
+    };
+
+    const ConversionPool::Timing pass = ConversionPool::Instance().ParallelBands(l.fieldRows, kMinRowsPerBand, [&](int f0, int f1) {
+        // The line above the band's first field line belongs to the previous band;
+        // convert it once more into scratch instead of waiting for that band.
+        thread_local std::vector<uint8_t> above;
+        const uint8_t* prev = nullptr;
+        if (f0 > 0) {
+            if (above.size() < rowBytesOut) above.resize(rowBytesOut);
+            convertField(f0 - 1, above.data());
+            prev = above.data();
+        }
+
+        for (int fieldY = f0; fieldY < f1; ++fieldY) {
+            const int frameY = fieldY * 2 + l.sourceParity;
+            uint8_t* cur = rowPtr(frameY);
+            convertField(fieldY, cur);
+
+            if (frameY > 0) {
+                uint8_t* missing = rowPtr(frameY - 1);
+                if (prev) {
+                    AverageRows(sixteenBit, prev, cur, missing, rowBytesOut);
+                }
+                else {
+                    std::memcpy(missing, cur, rowBytesOut);     // top edge: only a line below
+                }
+            }
+            prev = cur;
+        }
+
+        // Bottom edge: a missing last row only has the line above it.
+        const int lastFrameY = (l.fieldRows - 1) * 2 + l.sourceParity;
+        if (f1 == l.fieldRows && lastFrameY + 1 < H) {
+            std::memcpy(rowPtr(lastFrameY + 1), prev, rowBytesOut);
+        }
+    });
+
+    timing.wallNs += pass.wallNs;
+    timing.workNs += pass.workNs;
+    return true;
+}
+
+void UYVY_to_BGRA_FrameBob_Rows(const uint8_t* src,
+                                int srcPitch,
+                                uint8_t* dst,
+                                int dstPitch,
+                                int W,
+                                int H,
+                                bool keepEvenRows,
+                                bool flipY,
+                                ColorMatrix matrix,
+                                int y0,
+                                int y1)
+{
+    const UYVYRowKernel convert = GetUYVYRowKernel(SelectedConversionPath(), matrix);
+    if (y0 < 0) y0 = 0;
+    if (y1 > H) y1 = H;
+    if (W <= 0 || y0 >= y1) return;
+
+    const int fieldParity = keepEvenRows ? 0 : 1;
+    const size_t rowBytes = size_t(W) * 4;
+    auto srcRow = [&](int y) { return src + size_t(flipY ? (H - 1 - y) : y) * srcPitch; };
+    auto dstRow = [&](int y) { return dst + size_t(y) * dstPitch; };
+
+    for (int y = y0; y < y1; ++y) {
+        if ((y & 1) == fieldParity) convert(srcRow(y), dstRow(y), W);
+    }
+
+    thread_local std::vector<uint8_t> scratch;
+    if (scratch.size() < rowBytes * 2) scratch.resize(rowBytes * 2);
+
+    // A neighbour converted above, or (outside the range, or a missing row at an edge) into scratch.
+    auto neighbour = [&](int y, int slot) -> const uint8_t* {
+        if (y >= y0 && y < y1 && (y & 1) == fieldParity) return dstRow(y);
+        uint8_t* row = scratch.data() + rowBytes * slot;
+        convert(srcRow(y), row, W);
+        return row;
+    };
+
+    for (int y = y0; y < y1; ++y) {
+        if ((y & 1) == fieldParity) continue;
+        const uint8_t* up = neighbour(y > 0 ? y - 1 : y, 0);
+        const uint8_t* down = neighbour(y + 1 < H ? y + 1 : y, 1);
+        AverageRowsFloor8(up, down, dstRow(y), rowBytes);
+    }
+}
+
+void MotionAdaptiveDeinterlacer::Reset()
+{
+    for (Field& f : fields) f.parity = -1;
+    width = 0;
+    height = 0;
+}
+
+bool MotionAdaptiveDeinterlacer::Process(OutputFormat format,
+                                         ColorMatrix matrix,
+                                         bool raw,
+                                         const uint8_t* src,
+                                         size_t totalBytes,
+                                         uint8_t* dst,
+                                         int dstPitch,
+                                         int W,
+                                         int H,
+                                         bool evenField,
+                                         bool flipY,
+                                         ConversionPool::Timing& timing)
+{
+    FieldLayout l;
+    if (!src || !dst || !GetFieldLayout(SourcePacking::UYVY8, totalBytes, W, H, evenField, l)) return false;
+    if (W != width || H != height) {
+        Reset();
+        width = W;
+        height = H;
+    }
+
+    const int p = l.sourceParity;
+    Field& next = fields[3 - prev - prev2];
+    const Field& p1 = fields[prev];
+    const Field& p2 = fields[prev2];
+    const bool history = p1.parity == 1 - p && p2.parity == p;
+
+    next.rows.resize(l.rowBytes * size_t(l.fieldRows));
+    next.parity = p;
+    auto srcRow = [&](int fieldY) { return src + size_t(fieldY) * l.srcPitch; };
+
+    bool ok = true;
+    if (!history) {
+        ok = Convert422_Field_Bob(SourcePacking::UYVY8, format, matrix, raw, src, totalBytes, dst, dstPitch,
+                                  W, H, evenField, flipY, timing);
+        for (int f = 0; f < l.fieldRows; ++f) {
+            std::memcpy(next.rows.data() + size_t(f) * l.rowBytes, srcRow(f), l.rowBytes);
+        }
+    }
+    else {
+        const Convert422RowKernel convert = GetConvert422RowKernel(SourcePacking::UYVY8, format, matrix);
+        const ConversionPool::Timing pass = ConversionPool::Instance().ParallelBands(H, kMinRowsPerBand, [&](int y0, int y1) {
+            thread_local std::vector<uint8_t> line;
+            if (line.size() < l.rowBytes) line.resize(l.rowBytes);
+
+            for (int y = y0; y < y1; ++y) {
+                const int outputY = flipY ? (H - 1 - y) : y;
+                uint8_t* out = dst + size_t(outputY) * dstPitch;
+
+                if ((y & 1) == p) {
+                    // Captured line: keep it for the next fields and convert it.
+                    const int f = (y - p) / 2;
+                    std::memcpy(next.rows.data() + size_t(f) * l.rowBytes, srcRow(f), l.rowBytes);
+                    if (raw) std::memcpy(out, srcRow(f), l.rowBytes);
+                    else convert(srcRow(f), out, W, outputY);
+                    continue;
+                }
+
+                // Missing line; at the top/bottom edge both neighbours are the one line there is.
+                const int fu = ((y > 0 ? y - 1 : y + 1) - p) / 2;
+                const int fd = ((y + 1 < H ? y + 1 : y - 1) - p) / 2;
+                uint8_t* target = raw ? out : line.data();
+                MotionAdaptiveRow(srcRow(fu), srcRow(fd),
+                                  p1.rows.data() + size_t((y - (1 - p)) / 2) * l.rowBytes,
+                                  p2.rows.data() + size_t(fu) * l.rowBytes,
+                                  p2.rows.data() + size_t(fd) * l.rowBytes,
+                                  target, l.rowBytes);
+                if (!raw) convert(target, out, W, outputY);
+            }
+        });
+        timing.wallNs += pass.wallNs;
+        timing.workNs += pass.workNs;
+    }
+
+    const int spare = 3 - prev - prev2;
+    prev2 = prev;
+    prev = spare;
+    return ok;
+}
+
+std::string BenchmarkFieldBob(int W, int H, int iterations)
+{
+    std::ostringstream out;
+    if (W <= 0 || H <= 1 || (W & 1) != 0) {
+        out << "bob benchmark: invalid size " << W << "x" << H << "\n";
+        return out.str();
+    }
+    if (iterations <= 0) iterations = 1;
+
+    // One field's worth of random UYVY, converted as the odd and the even field in turn.
+    const int fieldRows = (H + 1) / 2;
+    std::vector<uint8_t> field(size_t(W) * 2 * fieldRows);
+    uint32_t state = 0x2468ACE1u;
+    for (auto& b : field) {
+        state = state * 1664525u + 1013904223u;
+        b = uint8_t(state >> 24);
+    }
+
+    out << "field bob " << W << "x" << H << " x" << iterations << " fields, "
+        << ConversionPool::Instance().ThreadCount() << " threads (50 Hz field period 20 ms)\n";
+
+    struct Case {
+        const char* name;
+        OutputFormat format;
+        bool raw;
+    };
+    const Case cases[] = {
+        { "UYVY->BGRA8 ", OutputFormat::BGRA8, false },
+        { "UYVY->RGBA16", OutputFormat::RGBA16, false },
+        { "UYVY raw    ", OutputFormat::BGRA8, true },
+    };
+
+    for (const Case& c : cases) {
+        const int pitch = c.raw ? W * 2 : W * OutputBytesPerPixel(c.format);
+        std::vector<uint8_t> reference(size_t(pitch) * H);
+        std::vector<uint8_t> fused(size_t(pitch) * H);
+
+        bool exact = true;
+        for (bool evenField : { false, true }) {
+            ConversionPool::Timing unused;
+            const size_t bytes = size_t(W) * 2 * ((H - (evenField ? 1 : 0) + 1) / 2);
+            Convert422_Field_Bob_TwoPass(SourcePacking::UYVY8, c.format, c.raw, field.data(), bytes,
+                                         reference.data(), pitch, W, H, evenField, !c.raw, unused);
+            Convert422_Field_Bob(SourcePacking::UYVY8, c.format, ColorMatrix::Bt601Limited, c.raw, field.data(), bytes,
+                                 fused.data(), pitch, W, H, evenField, !c.raw, unused);
+            exact = exact && std::memcmp(reference.data(), fused.data(), fused.size()) == 0;
+        }
+
+        auto time = [&](bool singlePass) {
+            ConversionPool::Timing timing;
+            for (int i = 0; i < iterations; ++i) {
+                const bool evenField = (i & 1) != 0;
+                const size_t bytes = size_t(W) * 2 * ((H - (evenField ? 1 : 0) + 1) / 2);
+                if (singlePass) {
+                    Convert422_Field_Bob(SourcePacking::UYVY8, c.format, ColorMatrix::Bt601Limited, c.raw, field.data(), bytes,
+                                         fused.data(), pitch, W, H, evenField, !c.raw, timing);
+                }
+                else {
+                    Convert422_Field_Bob_TwoPass(SourcePacking::UYVY8, c.format, c.raw, field.data(), bytes,
+                                                 reference.data(), pitch, W, H, evenField, !c.raw, timing);
+                }
+            }
+            return timing;
+        };
+        const ConversionPool::Timing twoPass = time(false);
+        const ConversionPool::Timing onePass = time(true);
+
+        auto ms = [&](long long ns) { return double(ns) / 1e6 / iterations; };
+        out << "  " << c.name << std::fixed << std::setprecision(3)
+            << "  two-pass " << std::setw(7) << ms(twoPass.wallNs) << " ms (" << std::setw(7) << ms(twoPass.workNs) << " cpu)"
+            << "  fused " << std::setw(7) << ms(onePass.wallNs) << " ms (" << std::setw(7) << ms(onePass.workNs) << " cpu)"
+            << std::setprecision(1) << "  " << std::setw(5) << 100.0 * ms(onePass.wallNs) / 20.0 << "% of field"
+            << (exact ? "" : "  MISMATCH vs two-pass") << "\n";
+    }
+
+    // Motion-adaptive: the SIMD line kernel against the scalar one, then whole
+    // fields of alternating parity once the history is primed.
+    {
+        const size_t rowBytes = size_t(W) * 2;
+        std::vector<uint8_t> simd(rowBytes), scalar(rowBytes);
+        const uint8_t* r = field.data();
+        const size_t rows = field.size() / rowBytes;
+        auto row = [&](size_t k) { return r + (k % rows) * rowBytes; };
+        MotionAdaptiveRow(row(0), row(1), row(2), row(3), row(4), simd.data(), rowBytes);
+        MotionAdaptiveRow_Scalar(row(0), row(1), row(2), row(3), row(4), scalar.data(), rowBytes);
+        const bool exact = simd == scalar;
+
+        for (OutputFormat format : { OutputFormat::BGRA8, OutputFormat::RGBA16 }) {
+            const int pitch = W * OutputBytesPerPixel(format);
+            std::vector<uint8_t> frame(size_t(pitch) * H);
+            MotionAdaptiveDeinterlacer deinterlacer;
+            ConversionPool::Timing timing;
+            auto run = [&](int i) {
+                const bool evenField = (i & 1) != 0;
+                const size_t bytes = rowBytes * ((H - (evenField ? 1 : 0) + 1) / 2);
+                deinterlacer.Process(format, ColorMatrix::Bt601Limited, false, field.data(), bytes, frame.data(), pitch,
+                                     W, H, evenField, true, timing);
+            };
+            run(0);
+            run(1);
+            timing = ConversionPool::Timing();
+            for (int i = 0; i < iterations; ++i) run(i);
+
+            const double wallMs = double(timing.wallNs) / 1e6 / iterations;
+            out << "  motion-adaptive " << (format == OutputFormat::RGBA16 ? "RGBA16" : "BGRA8 ")
+                << std::fixed << std::setprecision(3)
+                << "  " << std::setw(7) << wallMs << " ms (" << std::setw(7)
+                << double(timing.workNs) / 1e6 / iterations << " cpu)"
+                << std::setprecision(1) << "  " << std::setw(5) << 100.0 * wallMs / 20.0 << "% of field"
+                << (exact ? "" : "  MISMATCH vs scalar kernel") << "\n";
+        }
+    }
+    return out.str();
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "conversion_pool.hpp"
+#include "pixel_convert.hpp"
+
+// Deinterlacing of captured fields into full-height frames.
+//
+// The SDK returns the lines of one field contiguously; totalBytes may describe
+// either the field payload or a full-frame-sized slot allocation, so padding is
+// derived only for a half-frame payload and otherwise the natural packed row
+// size is used. Field 1/odd carries display rows 0,2,4...; field 2/even carries
+// display rows 1,3,5... (zero-based row coordinates).
+
+// Bob: field lines are converted to their natural parity and every missing line
+// is the average (rounded down) of the converted lines above and below it, or a
+// copy of the only neighbour at the top/bottom edge. Single pass: each band
+// converts its field lines and fills the missing line above each of them while
+// both neighbours are still in cache, so every output row is written once.
+//
+// With `raw` the packed rows are copied instead of converted (UYVY8 only: the
+// bytes of every 4:2:2 row carry the same component at the same offset, so they
+// average directly). Returns false if the buffer is too small for the field.
+bool Convert422_Field_Bob(SourcePacking packing,
+                          OutputFormat format,
+                          ColorMatrix matrix,
+                          bool raw,
+                          const uint8_t* src,
+                          size_t totalBytes,
+                          uint8_t* dst,
+                          int dstPitch,
+                          int W,
+                          int H,
+                          bool evenField,
+                          bool flipY,
+                          ConversionPool::Timing& timing);
+
+// Bob over a field-merged UYVY frame (the stereo path): writes output rows
+// [y0, y1) of the W x H BGRA image, keeping the output rows of one parity
+// (even rows when keepEvenRows) and replacing every other row with the average
+// (rounded down) of its converted neighbours, or of itself and its one
+// neighbour at the top/bottom edge. Output row y comes from source row
+// H - 1 - y with flipY. Field rows are converted straight into dst and missing
+// rows read them back from there, so disjoint row ranges can run in parallel
+// into one destination.
+void UYVY_to_BGRA_FrameBob_Rows(const uint8_t* src,
+                                int srcPitch,
+                                uint8_t* dst,
+                                int dstPitch,
+                                int W,
+                                int H,
+                                bool keepEvenRows,
+                                bool flipY,
+                                ColorMatrix matrix,
+                                int y0,
+                                int y1);
+
+// Motion-adaptive deinterlacing of 8-bit UYVY fields, one instance per stream.
+//
+// Keeps the two previous fields. A missing line takes the co-located line of the
+// previous field (weave: full vertical resolution), limited to within `d` of the
+// bob value, where `d` is how much the lines above and below changed since the
+// field of the same parity before. Static content therefore weaves and moving
+// content falls back to bob, per component. Lines are deinterlaced in UYVY and
+// then converted, so each output row is written once. Until two fields of
+// alternating parity are available (start, resolution change, dropped field)
+// the field is bobbed with Convert422_Field_Bob.
+class MotionAdaptiveDeinterlacer {
+public:
+    // Forget the field history (new capture session).
+    void Reset();
+
+    // Same contract as Convert422_Field_Bob for SourcePacking::UYVY8.
+    bool Process(OutputFormat format,
+                 ColorMatrix matrix,
+                 bool raw,
+                 const uint8_t* src,
+                 size_t totalBytes,
+                 uint8_t* dst,
+                 int dstPitch,
+                 int W,
+                 int H,
+                 bool evenField,
+                 bool flipY,
+                 ConversionPool::Timing& timing);
+
+private:
+    struct Field {
+        std::vector<uint8_t> rows;  // field lines, W * 2 bytes each
+        int parity = -1;            // frame row of line 0, -1 when empty
+    };
+
+    Field fields[3];
+    int prev = 0;                   // the previous field
+    int prev2 = 1;                  // the field before it
+    int width = 0;
+    int height = 0;
+};
+
+// Times the single-pass bob against the previous convert-then-interpolate
+// implementation on a synthetic W x H UYVY field pair, checks that both produce
+// the same frames, times the motion-adaptive deinterlacer, and returns a
+// human-readable report (ms per field, and the share of a 50 Hz field period).
+std::string BenchmarkFieldBob(int W, int H, int iterations);
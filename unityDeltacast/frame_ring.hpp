@@ -0,0 +1,133 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Lock-free frame publication for one stream (triple buffering).
+//
+// The capture thread converts straight into a buffer obtained from BeginWrite()
+// and makes it visible with Publish(), a single atomic index store. Readers pin
+// the latest published buffer with Acquire()/Release(); pinning is a reader
+// count on the buffer, and the producer only ever writes buffers that are neither
+// the latest one nor pinned. Nobody takes a lock, and the producer never waits:
+// if every other buffer is pinned, the frame is dropped instead.
+//
+// Lend()/ReturnLent() pin a frame on behalf of a consumer outside the plugin
+// (Unity reading the pixels in place); the loan is identified by the frame's
+// sequence number, and a lent buffer is never handed back to the producer
+// until it is returned.
+//
+// Acquire() and BeginWrite() form a Dekker-style handshake (reader: pin, then
+// re-check latest; producer: publish, then check pins), which is why those
+// operations use sequentially consistent ordering.
+class FrameRing {
+public:
+    // Triple buffering plus room for a lent frame and a second concurrent reader
+    // (e.g. the recorder), so the producer practically never has to drop.
+    static constexpr int kBuffers = 5;
+
+    struct Frame {
+        std::vector<uint8_t> data;
+        int width = 0;
+        int height = 0;
+        int pitch = 0;                  // bytes per row
+        unsigned int format = 0;        // pixel format tag, opaque to the ring
+        std::atomic<unsigned long long> seq{ 0 };
+        std::atomic<int> readers{ 0 };
+        std::atomic<int> lent{ 0 };     // subset of `readers` held through Lend()
+    };
+
+    // ---- producer (one capture thread) ----
+
+    // A buffer the producer may overwrite, sized to `bytes`, or nullptr when all
+    // non-latest buffers are pinned by readers.
+    Frame* BeginWrite(int width, int height, int pitch, unsigned int format, size_t bytes)
+    {
+        const int current = latest.load(std::memory_order_seq_cst);
+        for (int i = 0; i < kBuffers; ++i) {
+            if (i == current) continue;
+            Frame& f = frames[i];
+            if (f.readers.load(std::memory_order_seq_cst) != 0) continue;
+
+            if (f.data.size() != bytes) f.data.resize(bytes);
+            f.width = width;
+            f.height = height;
+            f.pitch = pitch;
+            f.format = format;
+            return &f;
+        }
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    void Publish(Frame* frame, unsigned long long seq)
+    {
+        frame->seq.store(seq, std::memory_order_relaxed);
+        latest.store(int(frame - frames), std::memory_order_seq_cst);
+    }
+
+    // Forget the published frame (capture restart). Pinned buffers stay intact.
+    void Reset()
+    {
+        latest.store(-1, std::memory_order_seq_cst);
+    }
+
+    // ---- readers (any thread) ----
+
+    // Pins and returns the latest published frame, or nullptr if none exists yet.
+    Frame* Acquire()
+    {
+        for (;;) {
+            const int i = latest.load(std::memory_order_seq_cst);
+            if (i < 0) return nullptr;
+
+            Frame& f = frames[i];
+            f.readers.fetch_add(1, std::memory_order_seq_cst);
+            if (latest.load(std::memory_order_seq_cst) == i) return &f;
+
+            // Superseded between the load and the pin: the producer may already be
+            // writing into it, so back off and retry with the new latest.
+            f.readers.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    void Release(Frame* frame)
+    {
+        if (frame) frame->readers.fetch_sub(1, std::memory_order_release);
+    }
+
+    // Acquire() for an external consumer; the pin is released by ReturnLent(seq).
+    Frame* Lend()
+    {
+        Frame* f = Acquire();
+        if (f) f->lent.fetch_add(1, std::memory_order_relaxed);
+        return f;
+    }
+
+    // Ends one loan of the frame with sequence number `seq`. Returns false if no
+    // frame with that sequence number is currently lent.
+    bool ReturnLent(unsigned long long seq)
+    {
+        for (Frame& f : frames) {
+            int l = f.lent.load(std::memory_order_relaxed);
+            // While lent, the buffer is pinned and its seq cannot change.
+            while (l > 0 && f.seq.load(std::memory_order_relaxed) == seq) {
+                if (f.lent.compare_exchange_weak(l, l - 1, std::memory_order_relaxed)) {
+                    Release(&f);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    // Frames the producer had to drop because no buffer was free.
+    unsigned long long Dropped() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    Frame frames[kBuffers];
+    std::atomic<int> latest{ -1 };
+    std::atomic<unsigned long long> dropped{ 0 };
+};
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Stage timestamps of the recently published frames of one stream.
+//
+// Each frame is stamped when it was captured, popped from the board, converted,
+// published and first fetched by a consumer, in steady_clock nanoseconds. The
+// log keeps the last kFrames frames, indexed by sequence number, so a consumer
+// can look up the frame it just read and rolling percentiles cover a few
+// seconds of video.
+//
+// The producer (whoever publishes to the stream's FrameRing, one at a time)
+// writes a whole entry with Record(); entries are versioned by their sequence
+// number like a seqlock, so a reader racing with the reuse of an entry sees it
+// missing rather than torn. Consumers only add the fetch stamp, once.
+class FrameTimingLog {
+public:
+    static constexpr int kFrames = 256;
+
+    enum Stage { Captured, Popped, Converted, Published, Fetched, kStages };
+
+    struct Stamps {
+        int64_t ns[kStages] = {};       // steady_clock time of each stage, 0 = not reached
+    };
+
+    static int64_t Now()
+    {
+        return ToNs(std::chrono::steady_clock::now());
+    }
+
+    static int64_t ToNs(std::chrono::steady_clock::time_point t)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+    }
+
+    // Forget every frame (capture restart). Only call while nothing publishes.
+    void Reset()
+    {
+        for (Entry& e : entries) e.seq.store(0, std::memory_order_relaxed);
+    }
+
+    // ---- producer ----
+
+    // Stamps frame `seq` (non-zero) with the stages up to Published.
+    void Record(unsigned long long seq, const Stamps& stamps)
+    {
+        Entry& e = entries[seq % kFrames];
+        e.seq.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (int s = 0; s < Fetched; ++s) e.ns[s].store(stamps.ns[s], std::memory_order_relaxed);
+        e.ns[Fetched].store(0, std::memory_order_relaxed);
+        e.seq.store(seq, std::memory_order_release);
+    }
+
+    // ---- readers (any thread) ----
+
+    // Stamps the first fetch of frame `seq`; later fetches keep the first stamp.
+    // Returns the time from publish to this fetch in ns if this call stamped it,
+    // else -1.
+    int64_t MarkFetched(unsigned long long seq)
+    {
+        if (seq == 0) return -1;
+        Entry& e = entries[seq % kFrames];
+        if (e.seq.load(std::memory_order_acquire) != seq) return -1;
+        const int64_t published = e.ns[Published].load(std::memory_order_relaxed);
+        const int64_t now = Now();
+        int64_t expected = 0;
+        if (!e.ns[Fetched].compare_exchange_strong(expected, now, std::memory_order_relaxed)) return -1;
+        return published != 0 ? now - published : -1;
+    }
+
+    // The stamps of frame `seq`, or false once it has left the log.
+    bool Lookup(unsigned long long seq, Stamps& out) const
+    {
+        if (seq == 0) return false;
+        const Entry& e = entries[seq % kFrames];
+        if (e.seq.load(std::memory_order_acquire) != seq) return false;
+        for (int s = 0; s < kStages; ++s) out.ns[s] = e.ns[s].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return e.seq.load(std::memory_order_relaxed) == seq;
+    }
+
+    // Median and 99th percentile, in ms, of the time from stage `from` to stage
+    // `to` over the logged frames that reached both. Returns how many did.
+    int Percentiles(Stage from, Stage to, double& p50, double& p99) const
+    {
+        p50 = p99 = 0.0;
+        thread_local std::vector<int64_t> spans;
+        spans.clear();
+        for (const Entry& e : entries) {
+            const unsigned long long seq = e.seq.load(std::memory_order_relaxed);
+            Stamps st;
+            if (!Lookup(seq, st) || st.ns[from] == 0 || st.ns[to] == 0) continue;
+            spans.push_back(st.ns[to] - st.ns[from]);
+        }
+        if (spans.empty()) return 0;
+
+        // Nearest-rank percentiles.
+        auto rank = [&](double p) {
+            const size_t k = std::min(spans.size(), size_t(std::ceil(p * double(spans.size())))) - 1;
+            std::nth_element(spans.begin(), spans.begin() + k, spans.end());
+            return double(spans[k]) / 1e6;
+        };
+        p50 = rank(0.50);
+        p99 = rank(0.99);
+        return int(spans.size());
+    }
+
+private:
+    struct Entry {
+        std::atomic<unsigned long long> seq{ 0 };
+        std::atomic<int64_t> ns[kStages] = {};
+    };
+
+    Entry entries[kFrames];
+};
+
+// Distribution of a per-frame duration (e.g. the conversion time) in 0.25 ms
+// buckets up to 64 ms plus an overflow bucket, and the exact maximum. Add() is
+// two relaxed atomic updates, so any thread may record without a lock;
+// Percentile() reads a bucket's upper bound and is meant for occasional polling.
+class LatencyHistogram {
+public:
+    static constexpr int kBuckets = 256;
+    static constexpr int64_t kBucketNs = 250000;
+
+    void Reset()
+    {
+        for (auto& b : buckets) b.store(0, std::memory_order_relaxed);
+        maxNs.store(0, std::memory_order_relaxed);
+    }
+
+    void Add(int64_t ns)
+    {
+        if (ns < 0) ns = 0;
+        const int64_t b = std::min<int64_t>(ns / kBucketNs, kBuckets);
+        buckets[b].fetch_add(1, std::memory_order_relaxed);
+        int64_t prev = maxNs.load(std::memory_order_relaxed);
+        while (ns > prev && !maxNs.compare_exchange_weak(prev, ns, std::memory_order_relaxed)) {}
+    }
+
+    // Upper bound of the bucket holding the p-quantile, in ms (the maximum for
+    // the overflow bucket); 0 before anything was recorded.
+    double Percentile(double p) const
+    {
+        unsigned long long counts[kBuckets + 1];
+        unsigned long long total = 0;
+        for (int b = 0; b <= kBuckets; ++b) total += counts[b] = buckets[b].load(std::memory_order_relaxed);
+        if (total == 0) return 0.0;
+
+        const unsigned long long rank = std::max<unsigned long long>(1, (unsigned long long)std::ceil(p * double(total)));
+        unsigned long long seen = 0;
+        for (int b = 0; b < kBuckets; ++b) {
+            seen += counts[b];
+            if (seen >= rank) return std::min(double((b + 1) * kBucketNs) / 1e6, MaxMs());
+        }
+        return MaxMs();
+    }
+
+    double MaxMs() const { return double(maxNs.load(std::memory_order_relaxed)) / 1e6; }
+
+private:
+    std::atomic<unsigned long long> buckets[kBuckets + 1] = {};
+    std::atomic<int64_t> maxNs{ 0 };
+};
@@ -0,0 +1,222 @@
+#include "log_ring.hpp"
+
+#include <chrono>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+LogRing& LogRing::Instance()
+{
+    static LogRing ring;
+    return ring;
+}
+
+LogRing::LogRing()
+    : records(new Record[kRecords])
+{
+    for (int i = 0; i < kRecords; ++i) records[i].sequence.store(size_t(i), std::memory_order_relaxed);
+}
+
+LogRing::~LogRing()
+{
+    // Free the strings of records nobody drained.
+    std::string unused;
+    Drain(unused);
+}
+
+LogRing::Record* LogRing::Claim()
+{
+    size_t pos = writePos.load(std::memory_order_relaxed);
+    for (;;) {
+        Record& r = records[pos % kRecords];
+        const size_t seq = r.sequence.load(std::memory_order_acquire);
+        if (seq == pos) {
+            if (writePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) return &r;
+        }
+        else if (seq < pos) {
+            // Still holds the record from one lap ago: the ring is full.
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        else {
+            pos = writePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void LogRing::Commit(Record* r)
+{
+    const size_t pos = r->sequence.load(std::memory_order_relaxed);
+    r->sequence.store(pos + 1, std::memory_order_release);
+}
+
+void LogRing::FreeArgs(Record& r)
+{
+    for (int i = 0; i < r.argCount; ++i) {
+        if (r.args[i].type == ArgType::HeapText) delete r.args[i].heap;
+    }
+    r.argCount = 0;
+}
+
+void LogRing::Format(const Record& r, std::string& out)
+{
+    const LogSite& site = *r.site;
+    out += '[';
+    out += site.file;
+    out += ':';
+    out += std::to_string(site.line);
+    out += ' ';
+    out += site.function;
+    out += "] ";
+    if (site.level == LogLevel::Warning) out += "warning: ";
+    if (site.level == LogLevel::Error) out += "error: ";
+
+    auto append = [&](const Arg& a) {
+        switch (a.type) {
+        case ArgType::Signed:   out += std::to_string(a.i); break;
+        case ArgType::Unsigned: out += std::to_string(a.u); break;
+        case ArgType::Double: {
+            std::ostringstream s;
+            s << a.d;
+            out += s.str();
+            break;
+        }
+        case ArgType::Text:     out.append(r.text + a.text.offset, a.text.length); break;
+        case ArgType::HeapText: out += *a.heap; break;
+        }
+    };
+
+    int next = 0;
+    for (const char* f = site.format; *f; ++f) {
+        if (f[0] == '{' && f[1] == '}' && next < r.argCount) {
+            append(r.args[next++]);
+            ++f;
+        }
+        else {
+            out += *f;
+        }
+    }
+    out += '\n';
+}
+
+void LogRing::Drain(std::string& out)
+{
+    for (;;) {
+        Record& r = records[readPos % kRecords];
+        if (r.sequence.load(std::memory_order_acquire) != readPos + 1) break;
+        Format(r, out);
+        FreeArgs(r);
+        r.sequence.store(readPos + kRecords, std::memory_order_release);
+        ++readPos;
+    }
+}
+
+namespace {
+
+// The DC_LOG of before: the whole line built in a std::string per call and
+// appended to a shared string under one mutex.
+std::mutex legacyMutex;
+std::string legacyMessage;
+
+void LegacyLog(const std::string& msg)
+{
+    std::lock_guard<std::mutex> lk(legacyMutex);
+    if (legacyMessage.size() < 2000) {
+        legacyMessage += msg + "\n";
+    }
+}
+
+#define LEGACY_DC_LOG(MSG)                                                 \
+    do {                                                                   \
+        LegacyLog( std::string("[") + __FILE__ + ":" +                     \
+                   std::to_string(__LINE__) + " " + __func__ + "] " +      \
+                   std::string(MSG) );                                     \
+    } while (0)
+
+// Runs `body(i)` for `iterations` calls on each of `threads` threads and returns
+// ns per call. The calls run in rounds of LogRing::kRecords in total; between
+// rounds, untimed, `drain` empties the log, so every timed call appends.
+template <class Body, class Drain>
+double TimePerCall(int threads, int iterations, Body body, Drain drain)
+{
+    const int perRound = LogRing::kRecords / threads;
+    const int rounds = (iterations + perRound - 1) / perRound;
+    std::atomic<int> arrived{ 0 };
+    std::atomic<long long> totalNs{ 0 };
+
+    // Spin barrier over the workers; `generation` counts completed barriers.
+    std::atomic<int> generation{ 0 };
+    auto barrier = [&] {
+        const int g = generation.load(std::memory_order_acquire);
+        if (arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == threads) {
+            arrived.store(0, std::memory_order_relaxed);
+            generation.store(g + 1, std::memory_order_release);
+        }
+        else {
+            while (generation.load(std::memory_order_acquire) == g) std::this_thread::yield();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            long long ns = 0;
+            for (int round = 0; round < rounds; ++round) {
+                const auto t0 = std::chrono::steady_clock::now();
+                for (int i = 0; i < perRound; ++i) body(round * perRound + i);
+                ns += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count();
+                barrier();
+                if (t == 0) drain();
+                barrier();
+            }
+            totalNs.fetch_add(ns, std::memory_order_relaxed);
+        });
+    }
+    for (std::thread& w : workers) w.join();
+    return double(totalNs.load()) / (double(threads) * rounds * perRound);
+}
+
+} // namespace
+
+std::string BenchmarkLogging(int iterations)
+{
+    if (iterations <= 0) iterations = 100000;
+
+    LogRing ring;
+    static const LogSite literalSite{ __FILE__, __LINE__, __func__, LogLevel::Info, "6" };
+    static const LogSite argSite{ __FILE__, __LINE__, __func__, LogLevel::Info, "width={}" };
+    std::string text;
+    auto drainRing = [&] { text.clear(); ring.Drain(text); };
+    auto drainLegacy = [] {
+        std::lock_guard<std::mutex> lk(legacyMutex);
+        legacyMessage.clear();
+    };
+
+    std::ostringstream out;
+    out << "logging, " << iterations << " calls per thread\n" << std::fixed << std::setprecision(1);
+    for (int threads : { 1, 4 }) {
+        const double legacyLiteral = TimePerCall(threads, iterations, [](int) { LEGACY_DC_LOG("6"); }, drainLegacy);
+        const double legacyArg = TimePerCall(threads, iterations, [](int i) {
+            LEGACY_DC_LOG("width=" + std::to_string(i));
+        }, drainLegacy);
+        const double ringLiteral = TimePerCall(threads, iterations, [&](int) { ring.Write(literalSite); }, drainRing);
+        const double ringArg = TimePerCall(threads, iterations, [&](int i) { ring.Write(argSite, i); }, drainRing);
+
+        out << "  " << threads << " thread" << (threads > 1 ? "s" : " ") << "  literal: legacy "
+            << std::setw(7) << legacyLiteral << " ns, ring " << std::setw(6) << ringLiteral << " ns"
+            << " | with int: legacy " << std::setw(7) << legacyArg << " ns, ring " << std::setw(6) << ringArg << " ns\n";
+    }
+    if (ring.Dropped() != 0) out << "  unexpected ring drops: " << ring.Dropped() << "\n";
+
+    // Drain cost, paid by GetMessage instead of the logging threads.
+    for (int i = 0; i < LogRing::kRecords; ++i) ring.Write(argSite, i);
+    text.clear();
+    const auto d0 = std::chrono::steady_clock::now();
+    ring.Drain(text);
+    const auto d1 = std::chrono::steady_clock::now();
+    out << "  drain: " << std::chrono::duration<double, std::nano>(d1 - d0).count() / LogRing::kRecords
+        << " ns per record formatted\n";
+    return out.str();
+}
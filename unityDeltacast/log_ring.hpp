@@ -0,0 +1,175 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// Plugin log: a preallocated lock-free ring of fixed-size records.
+//
+// A log call stores a pointer to its call site (file, line, function, level and
+// a format string, all static) and up to kMaxArgs arguments in one record;
+// nothing is formatted and, for arguments that fit the record, nothing is
+// allocated. The text is built only when the consumer drains the ring
+// (GetMessage). Any thread may write; one thread at a time drains. Claiming a
+// record is one CAS on the write position (a bounded MPMC queue with a
+// sequence number per record), and a full ring drops the new record and counts
+// it instead of waiting.
+//
+// Formats use "{}" placeholders, filled with the arguments in order: integers,
+// floating point, enums, bools, and strings (const char*, std::string,
+// std::string_view), which are copied. Levels below UNITYDELTACAST_LOG_LEVEL
+// compile to nothing, arguments included.
+
+enum class LogLevel : int { Debug = 0, Info = 1, Warning = 2, Error = 3 };
+
+#ifndef UNITYDELTACAST_LOG_LEVEL
+#  define UNITYDELTACAST_LOG_LEVEL 1    // Info
+#endif
+
+struct LogSite {
+    const char* file;
+    int line;
+    const char* function;
+    LogLevel level;
+    const char* format;
+};
+
+class LogRing {
+public:
+    static constexpr int kRecords = 1024;
+    static constexpr int kMaxArgs = 6;
+    static constexpr size_t kTextBytes = 64;   // inline string bytes per record
+
+    // The plugin's log.
+    static LogRing& Instance();
+
+    LogRing();
+    ~LogRing();
+    LogRing(const LogRing&) = delete;
+    LogRing& operator=(const LogRing&) = delete;
+
+    template <class... Args>
+    void Write(const LogSite& site, const Args&... args)
+    {
+        static_assert(sizeof...(Args) <= kMaxArgs, "too many log arguments");
+        Record* r = Claim();
+        if (!r) return;
+        r->site = &site;
+        r->argCount = 0;
+        r->textUsed = 0;
+        (Store(*r, args), ...);
+        Commit(r);
+    }
+
+    // Formats and removes every committed record, appending one line per record
+    // to `out`. One drainer at a time.
+    void Drain(std::string& out);
+
+    // Records dropped because the ring was full.
+    unsigned long long Dropped() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    enum class ArgType : uint8_t { Signed, Unsigned, Double, Text, HeapText };
+
+    struct Arg {
+        ArgType type;
+        union {
+            long long i;
+            unsigned long long u;
+            double d;
+            struct { uint16_t offset, length; } text;
+            std::string* heap;          // string too long for the record, freed on drain
+        };
+    };
+
+    struct Record {
+        std::atomic<size_t> sequence;
+        const LogSite* site;
+        uint8_t argCount;
+        uint8_t textUsed;
+        Arg args[kMaxArgs];
+        char text[kTextBytes];
+    };
+
+    Record* Claim();
+    void Commit(Record* r);
+    static void Format(const Record& r, std::string& out);
+
+    template <class T>
+    static void Store(Record& r, const T& value)
+    {
+        Arg& a = r.args[r.argCount++];
+        if constexpr (std::is_same_v<T, bool>) {
+            a.type = ArgType::Text;
+            StoreText(r, a, value ? "true" : "false");
+        }
+        else if constexpr (std::is_enum_v<T>) {
+            a.type = ArgType::Signed;
+            a.i = static_cast<long long>(value);
+        }
+        else if constexpr (std::is_floating_point_v<T>) {
+            a.type = ArgType::Double;
+            a.d = double(value);
+        }
+        else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            a.type = ArgType::Signed;
+            a.i = value;
+        }
+        else if constexpr (std::is_integral_v<T>) {
+            a.type = ArgType::Unsigned;
+            a.u = value;
+        }
+        else if constexpr (std::is_pointer_v<T>) {
+            StoreText(r, a, value ? std::string_view(value) : std::string_view("(null)"));
+        }
+        else {
+            StoreText(r, a, std::string_view(value));
+        }
+    }
+
+    static void StoreText(Record& r, Arg& a, std::string_view s)
+    {
+        if (s.size() <= kTextBytes - r.textUsed) {
+            a.type = ArgType::Text;
+            a.text.offset = r.textUsed;
+            a.text.length = uint16_t(s.size());
+            std::memcpy(r.text + r.textUsed, s.data(), s.size());
+            r.textUsed = uint8_t(r.textUsed + s.size());
+        }
+        else {
+            a.type = ArgType::HeapText;
+            a.heap = new std::string(s);
+        }
+    }
+
+    static void FreeArgs(Record& r);
+
+    std::unique_ptr<Record[]> records;
+    alignas(64) std::atomic<size_t> writePos{ 0 };
+    alignas(64) size_t readPos = 0;
+    std::atomic<unsigned long long> dropped{ 0 };
+};
+
+// Times DC_LOG against the previous string-building macro (std::string
+// concatenation appended to a shared string under a mutex), from 1 and 4
+// threads, for a literal message and one with an integer argument, and returns
+// a human-readable report (ns per call).
+std::string BenchmarkLogging(int iterations);
+
+#define DC_LOG_AT(LEVEL, FMT, ...)                                                      \
+    do {                                                                                \
+        if constexpr (int(LEVEL) >= UNITYDELTACAST_LOG_LEVEL) {                         \
+            static const LogSite dcLogSite{ __FILE__, __LINE__, __func__, LEVEL, FMT }; \
+            LogRing::Instance().Write(dcLogSite, ##__VA_ARGS__);                        \
+        }                                                                               \
+    } while (0)
+
+#define DC_LOG_DEBUG(FMT, ...) DC_LOG_AT(LogLevel::Debug, FMT, ##__VA_ARGS__)
+#define DC_LOG(FMT, ...)       DC_LOG_AT(LogLevel::Info, FMT, ##__VA_ARGS__)
+#define DC_LOG_WARN(FMT, ...)  DC_LOG_AT(LogLevel::Warning, FMT, ##__VA_ARGS__)
+#define DC_LOG_ERROR(FMT, ...) DC_LOG_AT(LogLevel::Error, FMT, ##__VA_ARGS__)
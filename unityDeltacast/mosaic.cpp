@@ -0,0 +1,233 @@
+#include "mosaic.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define UNITYDELTACAST_MOSAIC_SSE2 1
+#elif defined(UNITYDELTACAST_ARCH_NEON)
+#  include <arm_neon.h>
+#endif
+
+namespace {
+
+// Largest box side; keeps the summed components within 16 bits.
+constexpr int kMaxBox = 256;
+
+// acc[i] = sum of byte i over `rows` source rows.
+void SumRows(const uint8_t* src, size_t pitch, int rows, uint16_t* acc, size_t bytes)
+{
+    size_t i = 0;
+#if defined(UNITYDELTACAST_MOSAIC_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= bytes; i += 16) {
+        __m128i lo = zero;
+        __m128i hi = zero;
+        for (int r = 0; r < rows; ++r) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + r * pitch + i));
+            lo = _mm_add_epi16(lo, _mm_unpacklo_epi8(v, zero));
+            hi = _mm_add_epi16(hi, _mm_unpackhi_epi8(v, zero));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(acc + i), lo);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(acc + i + 8), hi);
+    }
+#elif defined(UNITYDELTACAST_ARCH_NEON)
+    for (; i + 16 <= bytes; i += 16) {
+        uint16x8_t lo = vdupq_n_u16(0);
+        uint16x8_t hi = vdupq_n_u16(0);
+        for (int r = 0; r < rows; ++r) {
+            const uint8x16_t v = vld1q_u8(src + r * pitch + i);
+            lo = vaddw_u8(lo, vget_low_u8(v));
+            hi = vaddw_u8(hi, vget_high_u8(v));
+        }
+        vst1q_u16(acc + i, lo);
+        vst1q_u16(acc + i + 8, hi);
+    }
+#endif
+    for (; i < bytes; ++i) {
+        unsigned sum = 0;
+        for (int r = 0; r < rows; ++r) sum += src[r * pitch + i];
+        acc[i] = uint16_t(sum);
+    }
+}
+
+// Box-averages the summed UYVY rows horizontally into a tileW-pixel UYVY row:
+// output pixel pair j averages 2 * kx source pixels from the chroma pair nearest
+// to its position, luma per pixel and chroma over the kx pairs. The division by
+// the box size is a rounded 8.24 fixed-point reciprocal (exact for power-of-two
+// boxes, within one code value otherwise).
+void ReduceRow(const uint16_t* acc, int srcW, int tileW, int kx, int ky, uint8_t* out)
+{
+    const uint64_t n = uint64_t(kx) * uint64_t(ky);
+    const uint64_t reciprocal = ((uint64_t(1) << 24) + n / 2) / n;
+    auto average = [&](unsigned sum) { return uint8_t((sum * reciprocal + (uint64_t(1) << 23)) >> 24); };
+
+    // Source position 2 * j * srcW / tileW, stepped without a division per pair.
+    const int step = (2 * srcW) / tileW;
+    const int stepRemainder = (2 * srcW) % tileW;
+    const int lastStart = srcW - 2 * kx;
+    int position = 0;
+    int remainder = 0;
+    for (int j = 0; j < tileW / 2; ++j) {
+        const uint16_t* a = acc + size_t(std::min(position & ~1, lastStart)) * 2;
+
+        unsigned u = 0, v = 0, y0 = 0, y1 = 0;
+        for (int k = 0; k < kx; ++k) {
+            u += a[4 * k];
+            v += a[4 * k + 2];
+            y0 += a[2 * k + 1];
+            y1 += a[2 * (kx + k) + 1];
+        }
+        out[4 * j + 0] = average(u);
+        out[4 * j + 1] = average(y0);
+        out[4 * j + 2] = average(v);
+        out[4 * j + 3] = average(y1);
+
+        position += step;
+        remainder += stepRemainder;
+        if (remainder >= tileW) {
+            ++position;
+            remainder -= tileW;
+        }
+    }
+}
+
+// ReduceRow for a source exactly twice the tile width and a power-of-two box
+// (kx = 2, ky = 1, 2, 4, ...; e.g. 1080p inputs in a 2x2 1080p mosaic): output
+// pair j is source pairs 2j and 2j + 1, so the sums are fixed lane shuffles and
+// the rounded division a shift. Same result as ReduceRow.
+void ReduceRowHalf(const uint16_t* acc, int tileW, int shift, uint8_t* out)
+{
+    const int pairs = tileW / 2;
+    int j = 0;
+#if defined(UNITYDELTACAST_MOSAIC_SSE2)
+    // Per output pair: 8 summed components U0 Y0 V0 Y1 U1 Y2 V1 Y3, as 32-bit
+    // lanes chroma [U0 V0 U1 V1] and luma [Y0 Y1 Y2 Y3].
+    const __m128i lowWord = _mm_set1_epi32(0xFFFF);
+    const __m128i rounding = _mm_set1_epi32((1 << shift) >> 1);
+    const __m128i count = _mm_cvtsi32_si128(shift);
+    auto pair = [&](const uint16_t* a) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a));
+        const __m128i chroma = _mm_and_si128(v, lowWord);
+        const __m128i luma = _mm_srli_epi32(v, 16);
+        const __m128i c = _mm_add_epi32(chroma, _mm_shuffle_epi32(chroma, _MM_SHUFFLE(3, 2, 3, 2)));  // [U V . .]
+        const __m128i l = _mm_add_epi32(luma, _mm_shuffle_epi32(luma, _MM_SHUFFLE(3, 3, 3, 1)));      // [Y0' . Y1' .]
+        const __m128i yuv = _mm_unpacklo_epi32(c, _mm_shuffle_epi32(l, _MM_SHUFFLE(3, 3, 2, 0)));    // [U Y0' V Y1']
+        return _mm_srl_epi32(_mm_add_epi32(yuv, rounding), count);
+    };
+    for (; j + 4 <= pairs; j += 4) {
+        const uint16_t* a = acc + size_t(j) * 8;
+        const __m128i lo = _mm_packs_epi32(pair(a), pair(a + 8));
+        const __m128i hi = _mm_packs_epi32(pair(a + 16), pair(a + 24));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + size_t(j) * 4), _mm_packus_epi16(lo, hi));
+    }
+#elif defined(UNITYDELTACAST_ARCH_NEON)
+    // vld4 splits 8 source pairs into U, Y0, V, Y1 vectors.
+    const int16x8_t count = vdupq_n_s16(int16_t(-shift));
+    auto quad = [](const uint16_t* a, uint16x4_t (&o)[4]) {
+        const uint16x8x4_t m = vld4q_u16(a);
+        const uint16x8_t luma = vaddq_u16(m.val[1], m.val[3]);
+        const uint16x4x2_t y = vuzp_u16(vget_low_u16(luma), vget_high_u16(luma));
+        o[0] = vpadd_u16(vget_low_u16(m.val[0]), vget_high_u16(m.val[0]));
+        o[1] = y.val[0];
+        o[2] = vpadd_u16(vget_low_u16(m.val[2]), vget_high_u16(m.val[2]));
+        o[3] = y.val[1];
+    };
+    for (; j + 8 <= pairs; j += 8) {
+        uint16x4_t lo[4], hi[4];
+        quad(acc + size_t(j) * 8, lo);
+        quad(acc + size_t(j) * 8 + 32, hi);
+        uint8x8x4_t o;
+        for (int k = 0; k < 4; ++k) o.val[k] = vmovn_u16(vrshlq_u16(vcombine_u16(lo[k], hi[k]), count));
+        vst4_u8(out + size_t(j) * 4, o);
+    }
+#endif
+    const unsigned round = (1u << shift) >> 1;
+    for (; j < pairs; ++j) {
+        const uint16_t* a = acc + size_t(j) * 8;
+        out[4 * j + 0] = uint8_t((a[0] + a[4] + round) >> shift);
+        out[4 * j + 1] = uint8_t((a[1] + a[3] + round) >> shift);
+        out[4 * j + 2] = uint8_t((a[2] + a[6] + round) >> shift);
+        out[4 * j + 3] = uint8_t((a[5] + a[7] + round) >> shift);
+    }
+}
+
+// Display row y of a tile, scaled and converted with `convert` into `out`
+// (tileW BGRA pixels).
+void ScaleTileRow(const MosaicTile& tile, UYVYRowKernel convert, int tileW, int tileH, int y, uint8_t* out)
+{
+    if (tile.srcWidth == tileW && tile.srcHeight == tileH) {
+        convert(tile.src + size_t(y) * tile.srcPitch, out, tileW);
+        return;
+    }
+
+    const int kx = std::clamp(tile.srcWidth / tileW, 1, kMaxBox);
+    const int ky = std::clamp(tile.srcHeight / tileH, 1, kMaxBox);
+    const int sy = std::min(int((long long)y * tile.srcHeight / tileH), tile.srcHeight - ky);
+
+    const size_t srcBytes = size_t(tile.srcWidth) * 2;
+    thread_local std::vector<uint16_t> acc;
+    thread_local std::vector<uint8_t> line;
+    if (acc.size() < srcBytes) acc.resize(srcBytes);
+    if (line.size() < size_t(tileW) * 2) line.resize(size_t(tileW) * 2);
+
+    SumRows(tile.src + size_t(sy) * tile.srcPitch, size_t(tile.srcPitch), ky, acc.data(), srcBytes);
+    const int box = 2 * ky;
+    if (tile.srcWidth == 2 * tileW && (box & (box - 1)) == 0) {
+        int shift = 0;
+        while ((1 << shift) < box) ++shift;
+        ReduceRowHalf(acc.data(), tileW, shift, line.data());
+    }
+    else {
+        ReduceRow(acc.data(), tile.srcWidth, tileW, kx, ky, line.data());
+    }
+    convert(line.data(), out, tileW);
+}
+
+} // namespace
+
+ConversionPool::Timing ComposeMosaic(const MosaicTile* tiles,
+                                     int count,
+                                     int columns,
+                                     int rows,
+                                     int tileW,
+                                     int tileH,
+                                     uint8_t* dst,
+                                     int dstPitch,
+                                     const uint8_t* previous)
+{
+    if (!dst || columns <= 0 || rows <= 0 || tileW <= 0 || tileH <= 0 || (tileW & 1) != 0) {
+        return ConversionPool::Timing();
+    }
+
+    const int outH = rows * tileH;
+    const size_t tileBytes = size_t(tileW) * 4;
+
+    // Each tile converts with its input's matrix; resolve the kernels once per frame.
+    std::vector<UYVYRowKernel> kernels(size_t(std::max(count, 0)));
+    for (int t = 0; t < count; ++t) {
+        kernels[t] = GetUYVYRowKernel(SelectedConversionPath(), tiles[t].matrix);
+    }
+
+    return ConversionPool::Instance().ParallelBands(rows * columns * tileH, kMinRowsPerBand, [&](int r0, int r1) {
+        for (int r = r0; r < r1; ++r) {
+            const int t = r / tileH;
+            const int y = r % tileH;
+            const int displayY = (t / columns) * tileH + y;
+            const size_t offset = size_t(outH - 1 - displayY) * dstPitch + size_t(t % columns) * tileBytes;
+
+            const MosaicTile* tile = t < count ? &tiles[t] : nullptr;
+            if (tile && tile->src && tile->srcWidth >= 2 && tile->srcHeight >= 1) {
+                ScaleTileRow(*tile, kernels[t], tileW, tileH, y, dst + offset);
+            }
+            else if (tile && previous) {
+                std::memcpy(dst + offset, previous + offset, tileBytes);
+            }
+            else {
+                std::memset(dst + offset, 0, tileBytes);
+            }
+        }
+    });
+}
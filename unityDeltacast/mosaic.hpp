@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "conversion_pool.hpp"
+#include "pixel_convert.hpp"
+
+// N-up mosaic composition: several UYVY inputs converted straight into the tiles
+// of one BGRA frame.
+//
+// Tiles are filled row by row, tile 0 top-left. The frame is stored bottom row
+// first like every other published BGRA frame, so a tile's display rows map to
+// mirrored memory rows. A source larger than its tile is box-filtered by the
+// integer ratio floor(src / tile) in each direction, with the boxes placed at
+// the nearest source position (exact box averaging for integer ratios, e.g. a
+// 1080p input in a 2x2 mosaic of 1080p); a smaller source is point-sampled.
+
+// One tile's input for a frame.
+struct MosaicTile {
+    const uint8_t* src = nullptr;   // UYVY, top row first; nullptr: no new frame
+    int srcPitch = 0;
+    int srcWidth = 0;               // even
+    int srcHeight = 0;
+    ColorMatrix matrix = ColorMatrix::Bt601Limited;
+};
+
+// Composes `count` tiles into a (columns * tileW) x (rows * tileH) BGRA frame in
+// one batch on the conversion pool; bands run over the rows of all tiles, so
+// the inputs convert concurrently. A tile without a source keeps its pixels from
+// `previous` (the last frame of the same geometry, may be null) or is cleared.
+// Tiles past `count` are cleared. tileW must be even.
+ConversionPool::Timing ComposeMosaic(const MosaicTile* tiles,
+                                     int count,
+                                     int columns,
+                                     int rows,
+                                     int tileW,
+                                     int tileH,
+                                     uint8_t* dst,
+                                     int dstPitch,
+                                     const uint8_t* previous);
+
@@ -0,0 +1,1155 @@
+#include "pixel_convert.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <type_traits>
+#include <vector>
+
+#if defined(UNITYDELTACAST_ARCH_X86)
+#  if defined(_MSC_VER)
+#    include <intrin.h>
+#  else
+#    include <cpuid.h>
+#  endif
+#endif
+
+static inline uint8_t clamp8(int x) {
+    return (uint8_t)(x < 0 ? 0 : x>255 ? 255 : x);
+}
+
+// Scalar reference, instantiated per matrix so the coefficients are
+// immediates. Every SIMD path must reproduce it byte for byte.
+template <ColorMatrix Matrix>
+void UYVY_to_BGRA_Row_Scalar(const uint8_t* s, uint8_t* d, int W)
+{
+    constexpr YuvToRgbMatrix M = YuvToRgb(Matrix);
+
+    for (int x = 0; x < W; x += 2) {
+        int U = int(s[0]) - 128;
+        int Y0 = int(s[1]);
+        int V = int(s[2]) - 128;
+        int Y1 = int(s[3]);
+        s += 4;
+
+        auto emit = [&](int Y) {
+            int C = Y - M.lumaOffset; if (C < 0) C = 0;
+            int R = clamp8((M.y * C + M.rv * V + 128) >> 8);
+            int G = clamp8((M.y * C - M.gu * U - M.gv * V + 128) >> 8);
+            int B = clamp8((M.y * C + M.bu * U + 128) >> 8);
+            *d++ = (uint8_t)B;
+            *d++ = (uint8_t)G;
+            *d++ = (uint8_t)R;
+            *d++ = 255; // A
+            };
+
+        emit(Y0);
+        emit(Y1);
+    }
+}
+
+// ---- 4:2:2 unpackers (scalar references) ----
+
+void Unpack_UYVY8_Row_Scalar(const uint8_t* src, uint16_t* dst, int W)
+{
+    for (int k = 0; k < W * 2; ++k) {
+        dst[k] = uint16_t(src[k] << 2);
+    }
+}
+
+// V210: three 10-bit components per little-endian 32-bit word (bits 0, 10, 20),
+// 12 components (6 pixels) per 16-byte group, already in U Y V Y order.
+void Unpack_YUV422_10_Row_Scalar(const uint8_t* src, uint16_t* dst, int W)
+{
+    for (int k = 0; k < W * 2; ++k) {
+        const uint8_t* w = src + (k / 3) * 4;
+        const uint32_t word = uint32_t(w[0]) | (uint32_t(w[1]) << 8) | (uint32_t(w[2]) << 16) | (uint32_t(w[3]) << 24);
+        dst[k] = uint16_t((word >> (10 * (k % 3))) & 0x3FF);
+    }
+}
+
+// Gapless 10-bit components, most significant bit first: 4 components (2 pixels)
+// per 5 bytes. Every component spans exactly two bytes of the stream.
+void Unpack_YUV422_10_BigEnd_Row_Scalar(const uint8_t* src, uint16_t* dst, int W)
+{
+    for (int k = 0; k < W * 2; ++k) {
+        const int bit = k * 10;
+        const uint8_t* b = src + bit / 8;
+        const int pair = (int(b[0]) << 8) | int(b[1]);
+        dst[k] = uint16_t((pair >> (6 - bit % 8)) & 0x3FF);
+    }
+}
+
+// 16-bit little-endian components; only the 10 most significant bits are kept.
+void Unpack_YUV422_16_Row_Scalar(const uint8_t* src, uint16_t* dst, int W)
+{
+    for (int k = 0; k < W * 2; ++k) {
+        dst[k] = uint16_t(((int(src[2 * k + 1]) << 8) | int(src[2 * k])) >> 6);
+    }
+}
+
+// ---- UYVY10 -> RGB (scalar references) ----
+//
+// Same matrix as the 8-bit path applied to 10-bit components, so the fixed-point
+// sum X = y*C + rv*V (etc.) carries 10 fractional bits instead of 8:
+//   BGRA8  : clamp8((X + dither) >> 10), dither = 64*kBayer4x4[row&3][x&3] + 32
+//   RGBA16 : clamp16((X*257 + 512) >> 10)          (65535/255 == 257)
+// For 10-bit input that is an 8-bit value << 2 the BGRA8 result equals the 8-bit
+// path exactly on average (dither mean 512 == the 8-bit rounding term).
+
+static inline uint16_t clamp16(int x) {
+    return (uint16_t)(x < 0 ? 0 : x > 65535 ? 65535 : x);
+}
+
+template <ColorMatrix M>
+void UYVY10_to_BGRA_Row_Scalar(const uint16_t* s, uint8_t* d, int W, int ditherRow)
+{
+    constexpr YuvToRgbMatrix m = YuvToRgb(M);
+    const int* bayer = kBayer4x4[ditherRow & 3];
+
+    for (int x = 0; x < W; x += 2) {
+        int U = int(s[0]) - 512;
+        int Y0 = int(s[1]);
+        int V = int(s[2]) - 512;
+        int Y1 = int(s[3]);
+        s += 4;
+
+        auto emit = [&](int Y, int px) {
+            int C = Y - m.lumaOffset * 4; if (C < 0) C = 0;
+            const int dither = bayer[px & 3] * 64 + 32;
+            *d++ = clamp8((m.y * C + m.bu * U + dither) >> 10);
+            *d++ = clamp8((m.y * C - m.gu * U - m.gv * V + dither) >> 10);
+            *d++ = clamp8((m.y * C + m.rv * V + dither) >> 10);
+            *d++ = 255; // A
+            };
+
+        emit(Y0, x);
+        emit(Y1, x + 1);
+    }
+}
+
+template <ColorMatrix M>
+void UYVY10_to_RGBA16_Row_Scalar(const uint16_t* s, uint16_t* d, int W)
+{
+    constexpr YuvToRgbMatrix m = YuvToRgb(M);
+
+    for (int x = 0; x < W; x += 2) {
+        int U = int(s[0]) - 512;
+        int Y0 = int(s[1]);
+        int V = int(s[2]) - 512;
+        int Y1 = int(s[3]);
+        s += 4;
+
+        auto emit = [&](int Y) {
+            int C = Y - m.lumaOffset * 4; if (C < 0) C = 0;
+            *d++ = clamp16(((m.y * C + m.rv * V) * 257 + 512) >> 10);
+            *d++ = clamp16(((m.y * C - m.gu * U - m.gv * V) * 257 + 512) >> 10);
+            *d++ = clamp16(((m.y * C + m.bu * U) * 257 + 512) >> 10);
+            *d++ = 65535; // A
+            };
+
+        emit(Y0);
+        emit(Y1);
+    }
+}
+
+template void UYVY_to_BGRA_Row_Scalar<ColorMatrix::Bt601Limited>(const uint8_t*, uint8_t*, int);
+template void UYVY_to_BGRA_Row_Scalar<ColorMatrix::Bt601Full>(const uint8_t*, uint8_t*, int);
+template void UYVY_to_BGRA_Row_Scalar<ColorMatrix::Bt709Limited>(const uint8_t*, uint8_t*, int);
+template void UYVY_to_BGRA_Row_Scalar<ColorMatrix::Bt709Full>(const uint8_t*, uint8_t*, int);
+template void UYVY_to_BGRA_Row_Scalar<ColorMatrix::Bt2020Limited>(const uint8_t*, uint8_t*, int);
+template void UYVY_to_BGRA_Row_Scalar<ColorMatrix::Bt2020Full>(const uint8_t*, uint8_t*, int);
+
+template void UYVY10_to_BGRA_Row_Scalar<ColorMatrix::Bt601Limited>(const uint16_t*, uint8_t*, int, int);
+template void UYVY10_to_BGRA_Row_Scalar<ColorMatrix::Bt601Full>(const uint16_t*, uint8_t*, int, int);
+template void UYVY10_to_BGRA_Row_Scalar<ColorMatrix::Bt709Limited>(const uint16_t*, uint8_t*, int, int);
+template void UYVY10_to_BGRA_Row_Scalar<ColorMatrix::Bt709Full>(const uint16_t*, uint8_t*, int, int);
+template void UYVY10_to_BGRA_Row_Scalar<ColorMatrix::Bt2020Limited>(const uint16_t*, uint8_t*, int, int);
+template void UYVY10_to_BGRA_Row_Scalar<ColorMatrix::Bt2020Full>(const uint16_t*, uint8_t*, int, int);
+
+template void UYVY10_to_RGBA16_Row_Scalar<ColorMatrix::Bt601Limited>(const uint16_t*, uint16_t*, int);
+template void UYVY10_to_RGBA16_Row_Scalar<ColorMatrix::Bt601Full>(const uint16_t*, uint16_t*, int);
+template void UYVY10_to_RGBA16_Row_Scalar<ColorMatrix::Bt709Limited>(const uint16_t*, uint16_t*, int);
+template void UYVY10_to_RGBA16_Row_Scalar<ColorMatrix::Bt709Full>(const uint16_t*, uint16_t*, int);
+template void UYVY10_to_RGBA16_Row_Scalar<ColorMatrix::Bt2020Limited>(const uint16_t*, uint16_t*, int);
+template void UYVY10_to_RGBA16_Row_Scalar<ColorMatrix::Bt2020Full>(const uint16_t*, uint16_t*, int);
+
+void UYVY_to_NV12_Rows_Scalar(const uint8_t* s0, const uint8_t* s1,
+                              uint8_t* y0, uint8_t* y1, uint8_t* uv, int W)
+{
+    for (int x = 0; x < W; x += 2) {
+        *y0++ = s0[1];
+        *y0++ = s0[3];
+        *y1++ = s1[1];
+        *y1++ = s1[3];
+        *uv++ = uint8_t((int(s0[0]) + int(s1[0]) + 1) >> 1);
+        *uv++ = uint8_t((int(s0[2]) + int(s1[2]) + 1) >> 1);
+        s0 += 4;
+        s1 += 4;
+    }
+}
+
+template <bool LimitedRange>
+static inline uint8_t RgbComponent(uint8_t v)
+{
+    if (!LimitedRange) return v;
+    const int c = v > 16 ? v - 16 : 0;
+    return clamp8((c * kRgbLimitedScale + 128) >> 8);
+}
+
+template <bool LimitedRange>
+void RGB24_to_BGRA_Row_Scalar(const uint8_t* s, uint8_t* d, int W)
+{
+    for (int x = 0; x < W; ++x) {
+        d[0] = RgbComponent<LimitedRange>(s[2]);
+        d[1] = RgbComponent<LimitedRange>(s[1]);
+        d[2] = RgbComponent<LimitedRange>(s[0]);
+        d[3] = 255;
+        s += 3;
+        d += 4;
+    }
+}
+
+template <bool LimitedRange>
+void RGB32_to_BGRA_Row_Scalar(const uint8_t* s, uint8_t* d, int W)
+{
+    for (int x = 0; x < W; ++x) {
+        d[0] = RgbComponent<LimitedRange>(s[2]);
+        d[1] = RgbComponent<LimitedRange>(s[1]);
+        d[2] = RgbComponent<LimitedRange>(s[0]);
+        d[3] = 255;
+        s += 4;
+        d += 4;
+    }
+}
+
+template void RGB24_to_BGRA_Row_Scalar<false>(const uint8_t*, uint8_t*, int);
+template void RGB24_to_BGRA_Row_Scalar<true>(const uint8_t*, uint8_t*, int);
+template void RGB32_to_BGRA_Row_Scalar<false>(const uint8_t*, uint8_t*, int);
+template void RGB32_to_BGRA_Row_Scalar<true>(const uint8_t*, uint8_t*, int);
+
+#if defined(UNITYDELTACAST_ARCH_X86)
+struct X86Features {
+    bool sse2 = false;
+    bool ssse3 = false;
+    bool avx2 = false;
+};
+
+static void Cpuid(int leaf, int subleaf, int regs[4])
+{
+#if defined(_MSC_VER)
+    __cpuidex(regs, leaf, subleaf);
+#else
+    unsigned int a = 0, b = 0, c = 0, d = 0;
+    __cpuid_count(leaf, subleaf, a, b, c, d);
+    regs[0] = int(a); regs[1] = int(b); regs[2] = int(c); regs[3] = int(d);
+#endif
+}
+
+static unsigned long long ReadXcr0()
+{
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    unsigned int lo = 0, hi = 0;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return (static_cast<unsigned long long>(hi) << 32) | lo;
+#endif
+}
+
+static X86Features DetectX86Features()
+{
+    X86Features f;
+    int regs[4] = {};
+    Cpuid(0, 0, regs);
+    const int maxLeaf = regs[0];
+    if (maxLeaf < 1) return f;
+
+    Cpuid(1, 0, regs);
+    f.sse2 = (regs[3] & (1 << 26)) != 0;
+    f.ssse3 = (regs[2] & (1 << 9)) != 0;
+
+    // AVX2 also needs the OS to save the upper YMM halves (OSXSAVE + XCR0[2:1]).
+    const bool osxsave = (regs[2] & (1 << 27)) != 0;
+    const bool avx = (regs[2] & (1 << 28)) != 0;
+    if (maxLeaf >= 7 && osxsave && avx && (ReadXcr0() & 0x6) == 0x6) {
+        Cpuid(7, 0, regs);
+        f.avx2 = (regs[1] & (1 << 5)) != 0;
+    }
+    return f;
+}
+
+static const X86Features& CpuFeatures()
+{
+    static const X86Features features = DetectX86Features();
+    return features;
+}
+#endif
+
+const char* ColorMatrixName(ColorMatrix matrix)
+{
+    switch (matrix) {
+    case ColorMatrix::Bt601Limited:  return "BT.601 limited";
+    case ColorMatrix::Bt601Full:     return "BT.601 full";
+    case ColorMatrix::Bt709Limited:  return "BT.709 limited";
+    case ColorMatrix::Bt709Full:     return "BT.709 full";
+    case ColorMatrix::Bt2020Limited: return "BT.2020 limited";
+    case ColorMatrix::Bt2020Full:    return "BT.2020 full";
+    default:                         return "unknown";
+    }
+}
+
+// Calls pick(std::integral_constant<ColorMatrix, M>()) with M == matrix, i.e.
+// maps a runtime matrix onto the kernel instantiated for it.
+template <typename Pick>
+static auto WithColorMatrix(ColorMatrix matrix, Pick pick)
+{
+    using C = ColorMatrix;
+    switch (matrix) {
+    case C::Bt601Full:     return pick(std::integral_constant<C, C::Bt601Full>());
+    case C::Bt709Limited:  return pick(std::integral_constant<C, C::Bt709Limited>());
+    case C::Bt709Full:     return pick(std::integral_constant<C, C::Bt709Full>());
+    case C::Bt2020Limited: return pick(std::integral_constant<C, C::Bt2020Limited>());
+    case C::Bt2020Full:    return pick(std::integral_constant<C, C::Bt2020Full>());
+    case C::Bt601Limited:
+    default:               return pick(std::integral_constant<C, C::Bt601Limited>());
+    }
+}
+
+const char* ConversionPathName(ConversionPath path)
+{
+    switch (path) {
+    case ConversionPath::Scalar: return "scalar";
+    case ConversionPath::SSE2:   return "SSE2";
+    case ConversionPath::SSSE3:  return "SSSE3";
+    case ConversionPath::AVX2:   return "AVX2";
+    case ConversionPath::NEON:   return "NEON";
+    default:                     return "unknown";
+    }
+}
+
+UYVYRowKernel GetUYVYRowKernel(ConversionPath path, ColorMatrix matrix)
+{
+    return WithColorMatrix(matrix, [path](auto m) -> UYVYRowKernel {
+        constexpr ColorMatrix M = decltype(m)::value;
+        switch (path) {
+        case ConversionPath::Scalar: return UYVY_to_BGRA_Row_Scalar<M>;
+#if defined(UNITYDELTACAST_ARCH_X86)
+        case ConversionPath::SSE2:   return UYVY_to_BGRA_Row_SSE2<M>;
+        case ConversionPath::SSSE3:  return UYVY_to_BGRA_Row_SSSE3<M>;
+        case ConversionPath::AVX2:   return UYVY_to_BGRA_Row_AVX2<M>;
+#endif
+#if defined(UNITYDELTACAST_ARCH_NEON)
+        case ConversionPath::NEON:   return UYVY_to_BGRA_Row_NEON<M>;
+#endif
+        default:                     return nullptr;
+        }
+    });
+}
+
+bool IsConversionPathSupported(ConversionPath path)
+{
+    if (!GetUYVYRowKernel(path)) return false;
+
+    switch (path) {
+    case ConversionPath::Scalar: return true;
+#if defined(UNITYDELTACAST_ARCH_X86)
+    case ConversionPath::SSE2:   return CpuFeatures().sse2;
+    case ConversionPath::SSSE3:  return CpuFeatures().ssse3;
+    case ConversionPath::AVX2:   return CpuFeatures().avx2;
+#endif
+#if defined(UNITYDELTACAST_ARCH_NEON)
+    case ConversionPath::NEON:   return true;   // only compiled in when the target guarantees NEON
+#endif
+    default:                     return false;
+    }
+}
+
+ConversionPath SelectedConversionPath()
+{
+    static const ConversionPath selected = [] {
+        const ConversionPath preference[] = {
+            ConversionPath::AVX2, ConversionPath::SSSE3, ConversionPath::SSE2, ConversionPath::NEON
+        };
+        for (ConversionPath p : preference) {
+            if (IsConversionPathSupported(p)) return p;
+        }
+        return ConversionPath::Scalar;
+    }();
+    return selected;
+}
+
+void UYVY_to_BGRA_Path(ConversionPath path,
+                       const uint8_t* src, int srcPitch, uint8_t* dst, int dstPitch,
+                       int W, int H, bool flipY, ColorMatrix matrix)
+{
+    UYVYRowKernel row = GetUYVYRowKernel(path, matrix);
+    if (!row) row = GetUYVYRowKernel(ConversionPath::Scalar, matrix);
+
+    for (int y = 0; y < H; ++y) {
+        const uint8_t* s = src + size_t(y) * srcPitch;
+        // write to bottom-up row if flipping
+        uint8_t* d = dst + size_t(flipY ? (H - 1 - y) : y) * dstPitch;
+        row(s, d, W);
+    }
+}
+
+void UYVY_to_BGRA(const uint8_t* src, int srcPitch, uint8_t* dst, int dstPitch,
+                  int W, int H, bool flipY, ColorMatrix matrix)
+{
+    GetConvert422RowsKernel(SourcePacking::UYVY8, OutputFormat::BGRA8, flipY, matrix)(src, srcPitch, dst, dstPitch, W, H, 0, H);
+}
+
+const char* SourcePackingName(SourcePacking packing)
+{
+    switch (packing) {
+    case SourcePacking::UYVY8:            return "YUV422_8";
+    case SourcePacking::YUV422_10:        return "YUV422_10";
+    case SourcePacking::YUV422_10_BigEnd: return "YUV422_10_NOPAD_BIGEND";
+    case SourcePacking::YUV422_16:        return "YUV422_16";
+    default:                              return "unknown";
+    }
+}
+
+int OutputBytesPerPixel(OutputFormat format)
+{
+    return format == OutputFormat::RGBA16 ? 8 : 4;
+}
+
+size_t PackedRowBytes(SourcePacking packing, int W)
+{
+    switch (packing) {
+    case SourcePacking::YUV422_10:        return size_t((W + 5) / 6) * 16;
+    case SourcePacking::YUV422_10_BigEnd: return (size_t(W) * 20 + 7) / 8;
+    case SourcePacking::YUV422_16:        return size_t(W) * 4;
+    case SourcePacking::UYVY8:
+    default:                              return size_t(W) * 2;
+    }
+}
+
+#if defined(UNITYDELTACAST_ARCH_X86)
+// The 10-bit kernels exist for SSE2 and SSSE3 only; wider paths use the best of those.
+static bool PathHasSSE2(ConversionPath path)
+{
+    return path == ConversionPath::SSE2 || path == ConversionPath::SSSE3 || path == ConversionPath::AVX2;
+}
+
+static bool PathHasSSSE3(ConversionPath path)
+{
+    return path == ConversionPath::SSSE3 || path == ConversionPath::AVX2;
+}
+#endif
+
+Unpack422RowKernel GetUnpack422RowKernel(SourcePacking packing, ConversionPath path)
+{
+    switch (packing) {
+    case SourcePacking::YUV422_10:
+#if defined(UNITYDELTACAST_ARCH_X86)
+        if (PathHasSSSE3(path)) return Unpack_YUV422_10_Row_SSSE3;
+#endif
+        return Unpack_YUV422_10_Row_Scalar;
+    case SourcePacking::YUV422_10_BigEnd:
+#if defined(UNITYDELTACAST_ARCH_X86)
+        if (PathHasSSSE3(path)) return Unpack_YUV422_10_BigEnd_Row_SSSE3;
+#endif
+        return Unpack_YUV422_10_BigEnd_Row_Scalar;
+    case SourcePacking::YUV422_16:
+#if defined(UNITYDELTACAST_ARCH_X86)
+        if (PathHasSSE2(path)) return Unpack_YUV422_16_Row_SSE2;
+#endif
+        return Unpack_YUV422_16_Row_Scalar;
+    case SourcePacking::UYVY8:
+    default:
+#if defined(UNITYDELTACAST_ARCH_X86)
+        if (PathHasSSE2(path)) return Unpack_UYVY8_Row_SSE2;
+#endif
+        return Unpack_UYVY8_Row_Scalar;
+    }
+}
+
+UYVY10ToBGRARowKernel GetUYVY10ToBGRARowKernel(ConversionPath path, ColorMatrix matrix)
+{
+    return WithColorMatrix(matrix, [path](auto m) -> UYVY10ToBGRARowKernel {
+        constexpr ColorMatrix M = decltype(m)::value;
+#if defined(UNITYDELTACAST_ARCH_X86)
+        if (PathHasSSE2(path)) return UYVY10_to_BGRA_Row_SSE2<M>;
+#endif
+        (void)path;
+        return UYVY10_to_BGRA_Row_Scalar<M>;
+    });
+}
+
+UYVY10ToRGBA16RowKernel GetUYVY10ToRGBA16RowKernel(ConversionPath path, ColorMatrix matrix)
+{
+    return WithColorMatrix(matrix, [path](auto m) -> UYVY10ToRGBA16RowKernel {
+        constexpr ColorMatrix M = decltype(m)::value;
+#if defined(UNITYDELTACAST_ARCH_X86)
+        if (PathHasSSE2(path)) return UYVY10_to_RGBA16_Row_SSE2<M>;
+#endif
+        (void)path;
+        return UYVY10_to_RGBA16_Row_Scalar<M>;
+    });
+}
+
+// One row through unpack + convert with explicitly chosen kernels. `scratch`
+// holds the UYVY10 row (2*W components).
+static void Convert422_RowWith(Unpack422RowKernel unpack, UYVY10ToBGRARowKernel toBGRA,
+                               UYVY10ToRGBA16RowKernel toRGBA16, OutputFormat format,
+                               const uint8_t* src, uint8_t* dst, int W, int outputRow,
+                               uint16_t* scratch)
+{
+    unpack(src, scratch, W);
+    if (format == OutputFormat::RGBA16) {
+        toRGBA16(scratch, reinterpret_cast<uint16_t*>(dst), W);
+    }
+    else {
+        toBGRA(scratch, dst, W, outputRow);
+    }
+}
+
+// Per-thread UYVY10 row buffer; capture and pool threads keep theirs across frames.
+static uint16_t* UYVY10Scratch(int W)
+{
+    thread_local std::vector<uint16_t> scratch;
+    if (scratch.size() < size_t(W) * 2) scratch.resize(size_t(W) * 2);
+    return scratch.data();
+}
+
+// The selected path's kernel of every stage for one matrix, resolved once.
+struct SelectedRowKernels {
+    UYVYRowKernel uyvy;
+    Unpack422RowKernel unpack[int(SourcePacking::Count)];
+    UYVY10ToBGRARowKernel toBGRA;
+    UYVY10ToRGBA16RowKernel toRGBA16;
+};
+
+template <ColorMatrix M>
+static const SelectedRowKernels& SelectedKernels()
+{
+    static const SelectedRowKernels k = [] {
+        SelectedRowKernels t{};
+        const ConversionPath path = SelectedConversionPath();
+        t.uyvy = GetUYVYRowKernel(path, M);
+        for (int p = 0; p < int(SourcePacking::Count); ++p) {
+            t.unpack[p] = GetUnpack422RowKernel(SourcePacking(p), path);
+        }
+        t.toBGRA = GetUYVY10ToBGRARowKernel(path, M);
+        t.toRGBA16 = GetUYVY10ToRGBA16RowKernel(path, M);
+        return t;
+    }();
+    return k;
+}
+
+// One row with packing and format fixed at compile time; `scratch` holds the
+// UYVY10 row and is unused by the direct 8-bit path.
+template <SourcePacking P, OutputFormat F>
+static inline void ConvertRowT(const SelectedRowKernels& k, const uint8_t* src, uint8_t* dst,
+                               int W, int outputRow, uint16_t* scratch)
+{
+    if constexpr (P == SourcePacking::UYVY8 && F == OutputFormat::BGRA8) {
+        k.uyvy(src, dst, W);
+    }
+    else {
+        k.unpack[int(P)](src, scratch, W);
+        if constexpr (F == OutputFormat::RGBA16) {
+            k.toRGBA16(scratch, reinterpret_cast<uint16_t*>(dst), W);
+        }
+        else {
+            k.toBGRA(scratch, dst, W, outputRow);
+        }
+    }
+}
+
+template <SourcePacking P, OutputFormat F>
+static uint16_t* ScratchFor(int W)
+{
+    if constexpr (P == SourcePacking::UYVY8 && F == OutputFormat::BGRA8) {
+        (void)W;
+        return nullptr;
+    }
+    else {
+        return UYVY10Scratch(W);
+    }
+}
+
+template <SourcePacking P, OutputFormat F>
+static void Convert422RowT(const SelectedRowKernels& k, const uint8_t* src, uint8_t* dst, int W, int outputRow)
+{
+    ConvertRowT<P, F>(k, src, dst, W, outputRow, ScratchFor<P, F>(W));
+}
+
+template <SourcePacking P, OutputFormat F>
+static void Convert422RowsT(const SelectedRowKernels& k, const uint8_t* src, int srcPitch, uint8_t* dst, int dstPitch,
+                            int W, int H, int y0, int y1, bool flipY)
+{
+    uint16_t* scratch = ScratchFor<P, F>(W);
+    for (int y = y0; y < y1; ++y) {
+        const int outY = flipY ? (H - 1 - y) : y;
+        ConvertRowT<P, F>(k, src + size_t(y) * srcPitch, dst + size_t(outY) * dstPitch, W, outY, scratch);
+    }
+}
+
+static const SelectedRowKernels& SelectedKernelsFor(ColorMatrix matrix)
+{
+    return *WithColorMatrix(matrix, [](auto m) { return &SelectedKernels<decltype(m)::value>(); });
+}
+
+template <SourcePacking P>
+static Convert422RowKernel RowKernelFor(OutputFormat format, const SelectedRowKernels& k)
+{
+    return { format == OutputFormat::RGBA16 ? Convert422RowT<P, OutputFormat::RGBA16>
+                                            : Convert422RowT<P, OutputFormat::BGRA8>, &k };
+}
+
+template <SourcePacking P>
+static Convert422RowsKernel RowsKernelFor(OutputFormat format, bool flipY, const SelectedRowKernels& k)
+{
+    return { format == OutputFormat::RGBA16 ? Convert422RowsT<P, OutputFormat::RGBA16>
+                                            : Convert422RowsT<P, OutputFormat::BGRA8>, &k, flipY };
+}
+
+Convert422RowKernel GetConvert422RowKernel(SourcePacking packing, OutputFormat format, ColorMatrix matrix)
+{
+    const SelectedRowKernels& k = SelectedKernelsFor(matrix);
+    switch (packing) {
+    case SourcePacking::YUV422_10:        return RowKernelFor<SourcePacking::YUV422_10>(format, k);
+    case SourcePacking::YUV422_10_BigEnd: return RowKernelFor<SourcePacking::YUV422_10_BigEnd>(format, k);
+    case SourcePacking::YUV422_16:        return RowKernelFor<SourcePacking::YUV422_16>(format, k);
+    case SourcePacking::UYVY8:
+    default:                              return RowKernelFor<SourcePacking::UYVY8>(format, k);
+    }
+}
+
+Convert422RowsKernel GetConvert422RowsKernel(SourcePacking packing, OutputFormat format, bool flipY,
+                                             ColorMatrix matrix)
+{
+    const SelectedRowKernels& k = SelectedKernelsFor(matrix);
+    switch (packing) {
+    case SourcePacking::YUV422_10:        return RowsKernelFor<SourcePacking::YUV422_10>(format, flipY, k);
+    case SourcePacking::YUV422_10_BigEnd: return RowsKernelFor<SourcePacking::YUV422_10_BigEnd>(format, flipY, k);
+    case SourcePacking::YUV422_16:        return RowsKernelFor<SourcePacking::YUV422_16>(format, flipY, k);
+    case SourcePacking::UYVY8:
+    default:                              return RowsKernelFor<SourcePacking::UYVY8>(format, flipY, k);
+    }
+}
+
+void Convert422_Row(SourcePacking packing, OutputFormat format,
+                    const uint8_t* src, uint8_t* dst, int W, int outputRow, ColorMatrix matrix)
+{
+    GetConvert422RowKernel(packing, format, matrix)(src, dst, W, outputRow);
+}
+
+void Convert422(SourcePacking packing, OutputFormat format,
+                const uint8_t* src, int srcPitch, uint8_t* dst, int dstPitch,
+                int W, int H, bool flipY, ColorMatrix matrix)
+{
+    GetConvert422RowsKernel(packing, format, flipY, matrix)(src, srcPitch, dst, dstPitch, W, H, 0, H);
+}
+
+UYVYToNV12RowsKernel GetUYVYToNV12RowsKernel(ConversionPath path)
+{
+    switch (path) {
+    case ConversionPath::Scalar: return UYVY_to_NV12_Rows_Scalar;
+#if defined(UNITYDELTACAST_ARCH_X86)
+    case ConversionPath::SSE2:
+    case ConversionPath::SSSE3:  return UYVY_to_NV12_Rows_SSE2;     // nothing to gain from pshufb
+    case ConversionPath::AVX2:   return UYVY_to_NV12_Rows_AVX2;
+#endif
+#if defined(UNITYDELTACAST_ARCH_NEON)
+    case ConversionPath::NEON:   return UYVY_to_NV12_Rows_NEON;
+#endif
+    default:                     return nullptr;
+    }
+}
+
+static void UYVY_to_NV12_With(UYVYToNV12RowsKernel rows, const uint8_t* src, int srcPitch,
+                              uint8_t* dstY, int dstYPitch, uint8_t* dstUV, int dstUVPitch,
+                              int W, int H)
+{
+    for (int y = 0; y < H; y += 2) {
+        const int y1 = y + 1 < H ? y + 1 : y;
+        rows(src + size_t(y) * srcPitch, src + size_t(y1) * srcPitch,
+             dstY + size_t(y) * dstYPitch, dstY + size_t(y1) * dstYPitch,
+             dstUV + size_t(y / 2) * dstUVPitch, W);
+    }
+}
+
+void UYVY_to_NV12(const uint8_t* src, int srcPitch,
+                  uint8_t* dstY, int dstYPitch, uint8_t* dstUV, int dstUVPitch,
+                  int W, int H)
+{
+    static const UYVYToNV12RowsKernel rows = GetUYVYToNV12RowsKernel(SelectedConversionPath());
+    UYVY_to_NV12_With(rows, src, srcPitch, dstY, dstYPitch, dstUV, dstUVPitch, W, H);
+}
+
+size_t NV12FrameBytes(int W, int H)
+{
+    return size_t(W) * H + size_t(W) * ((H + 1) / 2);
+}
+
+const char* RgbPackingName(RgbPacking packing)
+{
+    switch (packing) {
+    case RgbPacking::RGB24: return "RGB_24";
+    case RgbPacking::RGB32: return "RGB_32";
+    default:                return "?";
+    }
+}
+
+int RgbBytesPerPixel(RgbPacking packing)
+{
+    return packing == RgbPacking::RGB32 ? 4 : 3;
+}
+
+template <bool LimitedRange>
+static RgbRowKernel RgbRowKernelFor(RgbPacking packing, ConversionPath path)
+{
+    const bool rgb32 = (packing == RgbPacking::RGB32);
+    switch (path) {
+#if defined(UNITYDELTACAST_ARCH_X86)
+    case ConversionPath::AVX2:
+        return rgb32 ? RGB32_to_BGRA_Row_AVX2<LimitedRange> : RGB24_to_BGRA_Row_AVX2<LimitedRange>;
+    case ConversionPath::SSSE3:
+        return rgb32 ? RGB32_to_BGRA_Row_SSSE3<LimitedRange> : RGB24_to_BGRA_Row_SSSE3<LimitedRange>;
+#endif
+#if defined(UNITYDELTACAST_ARCH_NEON)
+    case ConversionPath::NEON:
+        return rgb32 ? RGB32_to_BGRA_Row_NEON<LimitedRange> : RGB24_to_BGRA_Row_NEON<LimitedRange>;
+#endif
+    default:    // the swizzle needs PSHUFB: SSE2 stays scalar
+        return rgb32 ? RGB32_to_BGRA_Row_Scalar<LimitedRange> : RGB24_to_BGRA_Row_Scalar<LimitedRange>;
+    }
+}
+
+RgbRowKernel GetRgbRowKernel(RgbPacking packing, bool limitedRange, ConversionPath path)
+{
+    return limitedRange ? RgbRowKernelFor<true>(packing, path) : RgbRowKernelFor<false>(packing, path);
+}
+
+static void RGB_to_BGRA_With(RgbRowKernel row, const uint8_t* src, int srcPitch,
+                             uint8_t* dst, int dstPitch, int W, int H, bool flipY)
+{
+    for (int y = 0; y < H; ++y) {
+        const int outY = flipY ? (H - 1 - y) : y;
+        row(src + size_t(y) * srcPitch, dst + size_t(outY) * dstPitch, W);
+    }
+}
+
+void RGB_to_BGRA(RgbPacking packing, bool limitedRange,
+                 const uint8_t* src, int srcPitch, uint8_t* dst, int dstPitch,
+                 int W, int H, bool flipY)
+{
+    RGB_to_BGRA_With(GetRgbRowKernel(packing, limitedRange, SelectedConversionPath()),
+                     src, srcPitch, dst, dstPitch, W, H, flipY);
+}
+
+// Times the unpack + convert pipeline of one packing/format with the kernels of
+// `path`, and compares the result with the scalar kernels.
+static void Benchmark422Path(std::ostringstream& out, SourcePacking packing, OutputFormat format,
+                             ConversionPath path, const std::vector<uint8_t>& src, int W, int H,
+                             int iterations, double baselineMpixPerSec)
+{
+    const size_t srcPitch = PackedRowBytes(packing, W);
+    const size_t dstPitch = size_t(W) * OutputBytesPerPixel(format);
+    std::vector<uint8_t> reference(dstPitch * H);
+    std::vector<uint8_t> dst(dstPitch * H);
+    std::vector<uint16_t> scratch(size_t(W) * 2);
+
+    auto run = [&](ConversionPath p, std::vector<uint8_t>& out) {
+        const Unpack422RowKernel unpack = GetUnpack422RowKernel(packing, p);
+        const UYVY10ToBGRARowKernel toBGRA = GetUYVY10ToBGRARowKernel(p);
+        const UYVY10ToRGBA16RowKernel toRGBA16 = GetUYVY10ToRGBA16RowKernel(p);
+        for (int y = 0; y < H; ++y) {
+            Convert422_RowWith(unpack, toBGRA, toRGBA16, format, src.data() + y * srcPitch,
+                               out.data() + y * dstPitch, W, y, scratch.data());
+        }
+    };
+
+    run(ConversionPath::Scalar, reference);
+
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        run(path, dst);
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+
+    const double seconds = std::chrono::duration<double>(t1 - t0).count();
+    const double mpixPerSec = seconds > 0 ? double(W) * H * iterations / 1e6 / seconds : 0.0;
+    const bool exact = std::memcmp(dst.data(), reference.data(), dst.size()) == 0;
+
+    out << "  " << std::left << std::setw(23) << SourcePackingName(packing)
+        << std::setw(7) << (format == OutputFormat::RGBA16 ? "RGBA16" : "BGRA8")
+        << std::setw(7) << ConversionPathName(path)
+        << std::right << std::fixed << std::setprecision(1)
+        << std::setw(9) << mpixPerSec << " Mpixels/s";
+    if (baselineMpixPerSec > 0) {
+        out << "  (" << std::setprecision(2) << mpixPerSec / baselineMpixPerSec << "x 8-bit)";
+    }
+    out << (exact ? "" : "  MISMATCH vs scalar") << "\n";
+}
+
+std::string BenchmarkConversionPaths(int W, int H, int iterations)
+{
+    std::ostringstream out;
+    if (W <= 0 || H <= 0 || (W & 1) != 0) {
+        out << "benchmark: invalid size " << W << "x" << H << "\n";
+        return out.str();
+    }
+    if (iterations <= 0) iterations = 1;
+
+    const int srcPitch = W * 2;
+    const int dstPitch = W * 4;
+    std::vector<uint8_t> src(size_t(srcPitch) * H);
+    std::vector<uint8_t> reference(size_t(dstPitch) * H);
+    std::vector<uint8_t> dst(size_t(dstPitch) * H);
+
+    // Deterministic pseudo-random content so every Y/U/V code (including the
+    // out-of-range ones that exercise clamping) is covered.
+    uint32_t state = 0x12345678u;
+    for (auto& b : src) {
+        state = state * 1664525u + 1013904223u;
+        b = uint8_t(state >> 24);
+    }
+
+    UYVY_to_BGRA_Path(ConversionPath::Scalar, src.data(), srcPitch, reference.data(), dstPitch, W, H, true);
+
+    out << "UYVY->BGRA " << W << "x" << H << " x" << iterations
+        << " (selected: " << ConversionPathName(SelectedConversionPath()) << ")\n";
+
+    double selectedMpixPerSec = 0.0;
+    for (int p = 0; p < int(ConversionPath::Count); ++p) {
+        const ConversionPath path = ConversionPath(p);
+        if (!IsConversionPathSupported(path)) continue;
+
+        std::memset(dst.data(), 0, dst.size());
+        const auto t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            UYVY_to_BGRA_Path(path, src.data(), srcPitch, dst.data(), dstPitch, W, H, true);
+        }
+        const auto t1 = std::chrono::steady_clock::now();
+
+        const double seconds = std::chrono::duration<double>(t1 - t0).count();
+        const double mpix = double(W) * H * iterations / 1e6;
+        const bool exact = std::memcmp(dst.data(), reference.data(), dst.size()) == 0;
+
+        out << "  " << std::left << std::setw(7) << ConversionPathName(path)
+            << std::right << std::fixed << std::setprecision(1)
+            << std::setw(9) << (seconds > 0 ? mpix / seconds : 0.0) << " Mpixels/s"
+            << (exact ? "" : "  MISMATCH vs scalar") << "\n";
+        if (path == SelectedConversionPath() && seconds > 0) selectedMpixPerSec = mpix / seconds;
+    }
+
+    // NV12 (recorder feed), every supported path against the scalar kernel.
+    {
+        const size_t nv12Bytes = NV12FrameBytes(W, H);
+        std::vector<uint8_t> nv12Reference(nv12Bytes);
+        std::vector<uint8_t> nv12(nv12Bytes);
+        auto run = [&](ConversionPath path, std::vector<uint8_t>& out) {
+            UYVY_to_NV12_With(GetUYVYToNV12RowsKernel(path), src.data(), srcPitch,
+                              out.data(), W, out.data() + size_t(W) * H, W, W, H);
+        };
+        run(ConversionPath::Scalar, nv12Reference);
+
+        out << "UYVY->NV12\n";
+        for (int p = 0; p < int(ConversionPath::Count); ++p) {
+            const ConversionPath path = ConversionPath(p);
+            if (!IsConversionPathSupported(path)) continue;
+
+            std::memset(nv12.data(), 0, nv12.size());
+            const auto t0 = std::chrono::steady_clock::now();
+            for (int i = 0; i < iterations; ++i) {
+                run(path, nv12);
+            }
+            const auto t1 = std::chrono::steady_clock::now();
+
+            const double seconds = std::chrono::duration<double>(t1 - t0).count();
+            const double mpix = double(W) * H * iterations / 1e6;
+            const bool exact = std::memcmp(nv12.data(), nv12Reference.data(), nv12.size()) == 0;
+
+            out << "  " << std::left << std::setw(7) << ConversionPathName(path)
+                << std::right << std::fixed << std::setprecision(1)
+                << std::setw(9) << (seconds > 0 ? mpix / seconds : 0.0) << " Mpixels/s"
+                << (exact ? "" : "  MISMATCH vs scalar") << "\n";
+        }
+    }
+
+    // RGB 4:4:4, every supported path against the scalar kernel, per packing and
+    // range. Row pitches are padded like the board's.
+    for (int pk = 0; pk < int(RgbPacking::Count); ++pk) {
+        const RgbPacking packing = RgbPacking(pk);
+        const int rgbPitch = (W * RgbBytesPerPixel(packing) + 63) & ~63;
+        std::vector<uint8_t> rgb(size_t(rgbPitch) * H);
+        for (auto& b : rgb) {
+            state = state * 1664525u + 1013904223u;
+            b = uint8_t(state >> 24);
+        }
+        for (bool limitedRange : { false, true }) {
+            RGB_to_BGRA_With(GetRgbRowKernel(packing, limitedRange, ConversionPath::Scalar),
+                             rgb.data(), rgbPitch, reference.data(), dstPitch, W, H, true);
+
+            out << RgbPackingName(packing) << "->BGRA (" << (limitedRange ? "limited" : "full") << " range)\n";
+            for (int p = 0; p < int(ConversionPath::Count); ++p) {
+                const ConversionPath path = ConversionPath(p);
+                if (!IsConversionPathSupported(path)) continue;
+
+                const RgbRowKernel row = GetRgbRowKernel(packing, limitedRange, path);
+                std::memset(dst.data(), 0, dst.size());
+                const auto t0 = std::chrono::steady_clock::now();
+                for (int i = 0; i < iterations; ++i) {
+                    RGB_to_BGRA_With(row, rgb.data(), rgbPitch, dst.data(), dstPitch, W, H, true);
+                }
+                const auto t1 = std::chrono::steady_clock::now();
+
+                const double seconds = std::chrono::duration<double>(t1 - t0).count();
+                const double mpix = double(W) * H * iterations / 1e6;
+                const bool exact = std::memcmp(dst.data(), reference.data(), dst.size()) == 0;
+
+                out << "  " << std::left << std::setw(7) << ConversionPathName(path)
+                    << std::right << std::fixed << std::setprecision(1)
+                    << std::setw(9) << (seconds > 0 ? mpix / seconds : 0.0) << " Mpixels/s"
+                    << (exact ? "" : "  MISMATCH vs scalar") << "\n";
+            }
+        }
+    }
+
+    // 10/16-bit packings: unpack + convert, per output format, against the 8-bit
+    // path above. Random bytes are valid input for every packing.
+    out << "4:2:2 packings (unpack + convert)\n";
+    for (int pk = 0; pk < int(SourcePacking::Count); ++pk) {
+        const SourcePacking packing = SourcePacking(pk);
+        std::vector<uint8_t> packed(PackedRowBytes(packing, W) * H);
+        for (auto& b : packed) {
+            state = state * 1664525u + 1013904223u;
+            b = uint8_t(state >> 24);
+        }
+        for (OutputFormat format : { OutputFormat::BGRA8, OutputFormat::RGBA16 }) {
+            if (packing == SourcePacking::UYVY8 && format == OutputFormat::BGRA8) continue;
+            Benchmark422Path(out, packing, format, ConversionPath::Scalar, packed, W, H, iterations, selectedMpixPerSec);
+            if (SelectedConversionPath() != ConversionPath::Scalar) {
+                Benchmark422Path(out, packing, format, SelectedConversionPath(), packed, W, H, iterations, selectedMpixPerSec);
+            }
+        }
+    }
+    return out.str();
+}
+
+// Convert422_Row and Convert422 as they were before the per-frame kernels:
+// packing, format, flip and scratch resolved again on every row. Kept as the
+// benchmark baseline.
+static void Convert422_Row_Dispatched(SourcePacking packing, OutputFormat format,
+                                      const uint8_t* src, uint8_t* dst, int W, int outputRow)
+{
+    const SelectedRowKernels& k = SelectedKernels<ColorMatrix::Bt601Limited>();
+    if (packing == SourcePacking::UYVY8 && format == OutputFormat::BGRA8) {
+        k.uyvy(src, dst, W);
+        return;
+    }
+    Convert422_RowWith(k.unpack[int(packing)], k.toBGRA, k.toRGBA16, format,
+                       src, dst, W, outputRow, UYVY10Scratch(W));
+}
+
+static void Convert422_Dispatched(SourcePacking packing, OutputFormat format,
+                                  const uint8_t* src, int srcPitch, uint8_t* dst, int dstPitch,
+                                  int W, int H, bool flipY)
+{
+    for (int y = 0; y < H; ++y) {
+        const int outY = flipY ? (H - 1 - y) : y;
+        Convert422_Row_Dispatched(packing, format, src + size_t(y) * srcPitch, dst + size_t(outY) * dstPitch, W, outY);
+    }
+}
+
+std::string BenchmarkConversionDispatch(int W, int H, int iterations)
+{
+    std::ostringstream out;
+    if (W <= 0 || H <= 0 || (W & 1) != 0) {
+        out << "benchmark: invalid size " << W << "x" << H << "\n";
+        return out.str();
+    }
+    if (iterations <= 0) iterations = 1;
+
+    out << "4:2:2 conversion dispatch " << W << "x" << H << " x" << iterations
+        << " (" << ConversionPathName(SelectedConversionPath()) << ", flipped, ms per frame)\n";
+
+    uint32_t state = 0x12345678u;
+    const struct { SourcePacking packing; OutputFormat format; } cases[] = {
+        { SourcePacking::UYVY8, OutputFormat::BGRA8 },
+        { SourcePacking::YUV422_10, OutputFormat::BGRA8 },
+        { SourcePacking::YUV422_10, OutputFormat::RGBA16 },
+    };
+    for (const auto& c : cases) {
+        const size_t srcPitch = PackedRowBytes(c.packing, W);
+        const size_t dstPitch = size_t(W) * OutputBytesPerPixel(c.format);
+        std::vector<uint8_t> src(srcPitch * H);
+        for (auto& b : src) {
+            state = state * 1664525u + 1013904223u;
+            b = uint8_t(state >> 24);
+        }
+        std::vector<uint8_t> reference(dstPitch * H);
+        std::vector<uint8_t> dst(dstPitch * H);
+
+        auto time = [&](auto&& frame, std::vector<uint8_t>& target) {
+            const auto t0 = std::chrono::steady_clock::now();
+            for (int i = 0; i < iterations; ++i) {
+                frame(target);
+            }
+            const auto t1 = std::chrono::steady_clock::now();
+            return std::chrono::duration<double, std::milli>(t1 - t0).count() / iterations;
+        };
+
+        // Whole frames: a runtime flip and dispatch per row, against one kernel.
+        const double perRowMs = time([&](std::vector<uint8_t>& o) {
+            Convert422_Dispatched(c.packing, c.format, src.data(), int(srcPitch), o.data(), int(dstPitch), W, H, true);
+        }, reference);
+        const double perFrameMs = time([&](std::vector<uint8_t>& o) {
+            GetConvert422RowsKernel(c.packing, c.format, true, ColorMatrix::Bt601Limited)(src.data(), int(srcPitch), o.data(), int(dstPitch), W, H, 0, H);
+        }, dst);
+        bool exact = std::memcmp(dst.data(), reference.data(), dst.size()) == 0;
+
+        // Single rows, as the field-mode paths call them: kernel resolved per frame.
+        std::memset(dst.data(), 0, dst.size());
+        const double rowCallMs = time([&](std::vector<uint8_t>& o) {
+            const Convert422RowKernel row = GetConvert422RowKernel(c.packing, c.format, ColorMatrix::Bt601Limited);
+            for (int y = 0; y < H; ++y) {
+                row(src.data() + y * srcPitch, o.data() + size_t(H - 1 - y) * dstPitch, W, H - 1 - y);
+            }
+        }, dst);
+        exact = exact && std::memcmp(dst.data(), reference.data(), dst.size()) == 0;
+
+        out << "  " << std::left << std::setw(23) << SourcePackingName(c.packing)
+            << std::setw(7) << (c.format == OutputFormat::RGBA16 ? "RGBA16" : "BGRA8")
+            << std::right << std::fixed << std::setprecision(3)
+            << " per-row " << std::setw(7) << perRowMs
+            << "  per-frame " << std::setw(7) << perFrameMs
+            << "  row kernel " << std::setw(7) << rowCallMs
+            << "  (" << std::setprecision(2) << (perFrameMs > 0 ? perRowMs / perFrameMs : 0.0) << "x)"
+            << (exact ? "" : "  MISMATCH") << "\n";
+    }
+    return out.str();
+}
+
+// Luma weights the matrices are generated from, for the double-precision reference.
+static void ColorMatrixWeights(ColorMatrix matrix, double& kr, double& kb, bool& fullRange)
+{
+    switch (matrix) {
+    case ColorMatrix::Bt709Limited:
+    case ColorMatrix::Bt709Full:     kr = 0.2126; kb = 0.0722; break;
+    case ColorMatrix::Bt2020Limited:
+    case ColorMatrix::Bt2020Full:    kr = 0.2627; kb = 0.0593; break;
+    default:                         kr = 0.299;  kb = 0.114;  break;
+    }
+    fullRange = matrix == ColorMatrix::Bt601Full || matrix == ColorMatrix::Bt709Full || matrix == ColorMatrix::Bt2020Full;
+}
+
+std::string BenchmarkColorMatrices(int W, int H, int iterations)
+{
+    std::ostringstream out;
+    if (W <= 0 || H <= 0 || (W & 1) != 0) {
+        out << "benchmark: invalid size " << W << "x" << H << "\n";
+        return out.str();
+    }
+    if (iterations <= 0) iterations = 1;
+
+    const ConversionPath path = SelectedConversionPath();
+    out << "color matrices, UYVY->BGRA " << W << "x" << H << " x" << iterations
+        << " (" << ConversionPathName(path) << ")\n"
+        << "  8-bit error vs the double-precision equations over every Y/Cb/Cr code;\n"
+        << "  every kernel of the selected path checked against its scalar reference\n";
+
+    const int srcPitch = W * 2;
+    const int dstPitch = W * 4;
+    std::vector<uint8_t> src(size_t(srcPitch) * H);
+    uint32_t state = 0x12345678u;
+    for (auto& b : src) {
+        state = state * 1664525u + 1013904223u;
+        b = uint8_t(state >> 24);
+    }
+    std::vector<uint8_t> reference(size_t(dstPitch) * H);
+    std::vector<uint8_t> dst(size_t(dstPitch) * H);
+
+    // One row per (U, V): 128 pixel pairs covering every luma code.
+    std::vector<uint8_t> sweep(256 * 2);
+    std::vector<uint8_t> sweepOut(256 * 4);
+
+    double baselineMpixPerSec = 0.0;
+    for (int c = 0; c < int(ColorMatrix::Count); ++c) {
+        const ColorMatrix matrix = ColorMatrix(c);
+        const YuvToRgbMatrix& m = YuvToRgb(matrix);
+        double kr, kb;
+        bool fullRange;
+        ColorMatrixWeights(matrix, kr, kb, fullRange);
+        const double kg = 1.0 - kr - kb;
+        const double ys = fullRange ? 1.0 : 255.0 / 219.0;
+        const double cs = fullRange ? 1.0 : 255.0 / 224.0;
+
+        const UYVYRowKernel row = GetUYVYRowKernel(path, matrix);
+        int maxError = 0;
+        double errorSum = 0.0;
+        for (int u = 0; u < 256; ++u) {
+            for (int v = 0; v < 256; ++v) {
+                for (int j = 0; j < 128; ++j) {
+                    sweep[4 * j + 0] = uint8_t(u);
+                    sweep[4 * j + 1] = uint8_t(2 * j);
+                    sweep[4 * j + 2] = uint8_t(v);
+                    sweep[4 * j + 3] = uint8_t(2 * j + 1);
+                }
+                row(sweep.data(), sweepOut.data(), 256);
+
+                const double cb = (u - 128) * cs;
+                const double cr = (v - 128) * cs;
+                for (int y = 0; y < 256; ++y) {
+                    // Same luma floor as the kernels: codes below black are black.
+                    const double l = (y < m.lumaOffset ? 0 : y - m.lumaOffset) * ys;
+                    const double rgb[3] = {
+                        l + 2.0 * (1.0 - kb) * cb,
+                        l - 2.0 * (1.0 - kb) * kb / kg * cb - 2.0 * (1.0 - kr) * kr / kg * cr,
+                        l + 2.0 * (1.0 - kr) * cr,
+                    };
+                    for (int k = 0; k < 3; ++k) {
+                        const int expected = clamp8(int(rgb[k] + 256.5) - 256);
+                        const int error = std::abs(int(sweepOut[4 * y + k]) - expected);
+                        maxError = std::max(maxError, error);
+                        errorSum += error;
+                    }
+                }
+            }
+        }
+
+        auto time = [&](ConversionPath p) {
+            const auto t0 = std::chrono::steady_clock::now();
+            for (int i = 0; i < iterations; ++i) {
+                UYVY_to_BGRA_Path(p, src.data(), srcPitch, dst.data(), dstPitch, W, H, true, matrix);
+            }
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+            return seconds > 0 ? double(W) * H * iterations / 1e6 / seconds : 0.0;
+        };
+        UYVY_to_BGRA_Path(ConversionPath::Scalar, src.data(), srcPitch, reference.data(), dstPitch, W, H, true, matrix);
+        const double mpixPerSec = time(path);
+        bool exact = std::memcmp(dst.data(), reference.data(), dst.size()) == 0;
+        if (matrix == ColorMatrix::Bt601Limited) baselineMpixPerSec = mpixPerSec;
+
+        // The 10-bit kernels of the selected path against their scalar references.
+        std::vector<uint16_t> uyvy10(size_t(W) * 2);
+        std::vector<uint8_t> bgra10(size_t(W) * 4), bgra10Reference(size_t(W) * 4);
+        std::vector<uint16_t> rgba16(size_t(W) * 4), rgba16Reference(size_t(W) * 4);
+        for (size_t k = 0; k < uyvy10.size(); ++k) {
+            uyvy10[k] = uint16_t((src[k] << 2) | (src[k + 1] >> 6));
+        }
+        GetUYVY10ToBGRARowKernel(path, matrix)(uyvy10.data(), bgra10.data(), W, 1);
+        GetUYVY10ToBGRARowKernel(ConversionPath::Scalar, matrix)(uyvy10.data(), bgra10Reference.data(), W, 1);
+        GetUYVY10ToRGBA16RowKernel(path, matrix)(uyvy10.data(), rgba16.data(), W);
+        GetUYVY10ToRGBA16RowKernel(ConversionPath::Scalar, matrix)(uyvy10.data(), rgba16Reference.data(), W);
+        exact = exact && bgra10 == bgra10Reference && rgba16 == rgba16Reference;
+
+        out << "  " << std::left << std::setw(16) << ColorMatrixName(matrix)
+            << std::right << " max err " << maxError
+            << "  mean " << std::fixed << std::setprecision(3) << errorSum / (256.0 * 256 * 256 * 3)
+            << std::setprecision(1) << std::setw(9) << mpixPerSec << " Mpixels/s"
+            << "  (" << std::setprecision(2) << (baselineMpixPerSec > 0 ? mpixPerSec / baselineMpixPerSec : 0.0)
+            << "x BT.601 limited)"
+            << (exact ? "" : "  MISMATCH vs scalar") << "\n";
+    }
+    return out.str();
+}
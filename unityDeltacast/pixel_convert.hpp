@@ -0,0 +1,384 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Pixel format conversion kernels used by the capture threads.
+//
+// Every kernel family has a scalar reference implementation plus SIMD variants
+// that live in their own translation units (pixel_convert_<isa>.cpp) so they can
+// be compiled with the matching instruction-set flags. The best variant the CPU
+// supports is selected once at runtime; all variants are bit-exact with the
+// scalar reference.
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#  define UNITYDELTACAST_ARCH_X86 1
+#endif
+#if defined(_M_ARM64) || defined(__aarch64__) || defined(__ARM_NEON)
+#  define UNITYDELTACAST_ARCH_NEON 1
+#endif
+
+// Integer YCbCr -> RGB coefficients in 8.8 fixed point:
+//   R = (y*(Y-lumaOffset)              + rv*V + 128) >> 8
+//   G = (y*(Y-lumaOffset) - gu*U       - gv*V + 128) >> 8
+//   B = (y*(Y-lumaOffset) + bu*U              + 128) >> 8
+// with U/V centered on 0 and (Y-lumaOffset) clamped to >= 0.
+struct YuvToRgbMatrix {
+    int lumaOffset;
+    int y;
+    int rv;
+    int gu;
+    int gv;
+    int bu;
+};
+
+// Coefficients for luma weights kr/kb (kg = 1 - kr - kb), each rounded from
+// its exact value * 256. Limited range scales luma codes 16..235 and chroma
+// codes 16..240 to the full 0..255; full range uses the codes as they are.
+constexpr int RoundCoefficient(double k) { return int(k * 256.0 + 0.5); }
+constexpr YuvToRgbMatrix MakeYuvToRgbMatrix(double kr, double kb, bool fullRange)
+{
+    const double kg = 1.0 - kr - kb;
+    const double ys = fullRange ? 1.0 : 255.0 / 219.0;
+    const double cs = fullRange ? 1.0 : 255.0 / 224.0;
+    return YuvToRgbMatrix{
+        fullRange ? 0 : 16,
+        RoundCoefficient(ys),
+        RoundCoefficient(2.0 * (1.0 - kr) * cs),
+        RoundCoefficient(2.0 * (1.0 - kb) * kb / kg * cs),
+        RoundCoefficient(2.0 * (1.0 - kr) * kr / kg * cs),
+        RoundCoefficient(2.0 * (1.0 - kb) * cs),
+    };
+}
+
+// The conversion matrices a stream can use. Kernels are instantiated for each,
+// so the coefficients are compile-time constants in every path.
+enum class ColorMatrix {
+    Bt601Limited,       // SD
+    Bt601Full,
+    Bt709Limited,       // HD / UHD
+    Bt709Full,
+    Bt2020Limited,      // wide colour gamut UHD
+    Bt2020Full,
+    Count
+};
+
+constexpr YuvToRgbMatrix kYuvToRgbMatrices[int(ColorMatrix::Count)] = {
+    MakeYuvToRgbMatrix(0.299, 0.114, false),
+    MakeYuvToRgbMatrix(0.299, 0.114, true),
+    MakeYuvToRgbMatrix(0.2126, 0.0722, false),
+    MakeYuvToRgbMatrix(0.2126, 0.0722, true),
+    MakeYuvToRgbMatrix(0.2627, 0.0593, false),
+    MakeYuvToRgbMatrix(0.2627, 0.0593, true),
+};
+
+constexpr const YuvToRgbMatrix& YuvToRgb(ColorMatrix matrix) { return kYuvToRgbMatrices[int(matrix)]; }
+
+const char* ColorMatrixName(ColorMatrix matrix);
+
+constexpr bool SameCoefficients(const YuvToRgbMatrix& a, const YuvToRgbMatrix& b)
+{
+    return a.lumaOffset == b.lumaOffset && a.y == b.y && a.rv == b.rv
+        && a.gu == b.gu && a.gv == b.gv && a.bu == b.bu;
+}
+
+// Reference values: the 8.8 coefficients of the equations published with each
+// recommendation (e.g. BT.709 limited R = 1.164(Y-16) + 1.793(Cr-128)). The
+// BT.601 limited set is the one UYVY_to_BGRA has always used.
+static_assert(SameCoefficients(YuvToRgb(ColorMatrix::Bt601Limited), YuvToRgbMatrix{ 16, 298, 409, 100, 208, 516 }),
+              "BT.601 limited-range coefficients");
+static_assert(SameCoefficients(YuvToRgb(ColorMatrix::Bt601Full), YuvToRgbMatrix{ 0, 256, 359, 88, 183, 454 }),
+              "BT.601 full-range coefficients");
+static_assert(SameCoefficients(YuvToRgb(ColorMatrix::Bt709Limited), YuvToRgbMatrix{ 16, 298, 459, 55, 136, 541 }),
+              "BT.709 limited-range coefficients");
+static_assert(SameCoefficients(YuvToRgb(ColorMatrix::Bt709Full), YuvToRgbMatrix{ 0, 256, 403, 48, 120, 475 }),
+              "BT.709 full-range coefficients");
+static_assert(SameCoefficients(YuvToRgb(ColorMatrix::Bt2020Limited), YuvToRgbMatrix{ 16, 298, 430, 48, 167, 548 }),
+              "BT.2020 limited-range coefficients");
+static_assert(SameCoefficients(YuvToRgb(ColorMatrix::Bt2020Full), YuvToRgbMatrix{ 0, 256, 377, 42, 146, 482 }),
+              "BT.2020 full-range coefficients");
+
+// The SIMD kernels evaluate the formulas above in 16-bit lanes by splitting each
+// coefficient k into 256*HighPart(k) + LowPart(k): the high part is applied at
+// full scale and only the small low part goes through the >> 8, which keeps the
+// result bit-exact with the 32-bit scalar arithmetic.
+constexpr int HighPart(int k) { return (k + 128) >> 8; }
+constexpr int LowPart(int k) { return k - 256 * HighPart(k); }
+
+// Largest magnitude any of the three low-part accumulators can reach for 8-bit
+// input. Must stay below 32768 for the 16-bit split to be exact.
+constexpr int MaxLowPartAccumulator(const YuvToRgbMatrix& m)
+{
+    const int c = 255 - m.lumaOffset;
+    const int ry = (LowPart(m.y) < 0 ? -LowPart(m.y) : LowPart(m.y)) * c;
+    auto chroma = [](int k) { return (k < 0 ? -k : k) * 128; };
+    const int r = ry + chroma(LowPart(m.rv)) + 128;
+    const int g = ry + chroma(LowPart(m.gu)) + chroma(LowPart(m.gv)) + 128;
+    const int b = ry + chroma(LowPart(m.bu)) + 128;
+    return r > g ? (r > b ? r : b) : (g > b ? g : b);
+}
+constexpr bool AllMatricesFit16BitSplit()
+{
+    for (const YuvToRgbMatrix& m : kYuvToRgbMatrices) {
+        if (MaxLowPartAccumulator(m) >= 32768) return false;
+    }
+    return true;
+}
+static_assert(AllMatricesFit16BitSplit(), "a conversion matrix overflows the 16-bit SIMD split");
+
+enum class ConversionPath {
+    Scalar,
+    SSE2,
+    SSSE3,
+    AVX2,
+    NEON,
+    Count
+};
+
+// Converts `W` pixels (W even) of one packed UYVY row to BGRA.
+using UYVYRowKernel = void (*)(const uint8_t* src, uint8_t* dst, int W);
+
+const char* ConversionPathName(ConversionPath path);
+
+// True when `path` was compiled in and the running CPU supports it.
+bool IsConversionPathSupported(ConversionPath path);
+
+// Fastest supported path, detected once on first use.
+ConversionPath SelectedConversionPath();
+
+// Row kernel for `path` and `matrix`, or nullptr when the path was not compiled in.
+UYVYRowKernel GetUYVYRowKernel(ConversionPath path, ColorMatrix matrix = ColorMatrix::Bt601Limited);
+
+// UYVY (U Y0 V Y1) -> BGRA, optional vertical flip, using the selected path.
+void UYVY_to_BGRA(const uint8_t* src, int srcPitch, uint8_t* dst, int dstPitch,
+                  int W, int H, bool flipY, ColorMatrix matrix = ColorMatrix::Bt601Limited);
+
+// Same as UYVY_to_BGRA but forces a specific kernel path.
+void UYVY_to_BGRA_Path(ConversionPath path,
+                       const uint8_t* src, int srcPitch, uint8_t* dst, int dstPitch,
+                       int W, int H, bool flipY, ColorMatrix matrix = ColorMatrix::Bt601Limited);
+
+// ---- 4:2:2 source packings and output formats ----
+//
+// Every packing is first unpacked to a row of 10-bit components in U Y0 V Y1
+// order ("UYVY10", one uint16_t each), which is then converted to the output
+// format. 8-bit UYVY to BGRA8 keeps using the direct kernels above.
+
+// The VHD_BUFFERPACKING 4:2:2 layouts the capture path understands.
+enum class SourcePacking {
+    UYVY8,              // VHD_BUFPACK_VIDEO_YUV422_8
+    YUV422_10,          // VHD_BUFPACK_VIDEO_YUV422_10: V210, 6 pixels per 16 bytes
+    YUV422_10_BigEnd,   // VHD_BUFPACK_VIDEO_YUV422_10_NOPAD_BIGEND: 10-bit MSB-first bit stream
+    YUV422_16,          // VHD_BUFPACK_VIDEO_YUV422_16: 16-bit little-endian components
+    Count
+};
+
+enum class OutputFormat {
+    BGRA8,              // 8 bits per channel; 10-bit sources are ordered-dithered
+    RGBA16,             // 16 bits per channel, Unity TextureFormat.RGBA64
+};
+
+const char* SourcePackingName(SourcePacking packing);
+int OutputBytesPerPixel(OutputFormat format);
+
+// Bytes of one packed row of W pixels (without any padding the board adds).
+size_t PackedRowBytes(SourcePacking packing, int W);
+
+// Converts one packed row of W pixels (W even). `outputRow` is the row's index in
+// the destination frame and selects the dither pattern of BGRA8 output, so the
+// result does not depend on how a frame is split into bands.
+void Convert422_Row(SourcePacking packing, OutputFormat format,
+                    const uint8_t* src, uint8_t* dst, int W, int outputRow,
+                    ColorMatrix matrix = ColorMatrix::Bt601Limited);
+
+// Frame version of Convert422_Row, optional vertical flip.
+void Convert422(SourcePacking packing, OutputFormat format,
+                const uint8_t* src, int srcPitch, uint8_t* dst, int dstPitch,
+                int W, int H, bool flipY, ColorMatrix matrix = ColorMatrix::Bt601Limited);
+
+// ---- Per-frame specialized conversions ----
+//
+// Compile-time instantiations for every (packing, output format) combination,
+// bound to the selected path's row kernels for one matrix. Look one up once per
+// frame (or band batch) instead of calling Convert422_Row, which re-dispatches on
+// packing and format for every row. Matrix and flip stay runtime values: as
+// template axes they multiplied the instantiations without a measurable gain.
+
+struct SelectedRowKernels;
+
+// Convert422_Row for one fixed packing, format and matrix.
+struct Convert422RowKernel {
+    void (*row)(const SelectedRowKernels& k, const uint8_t* src, uint8_t* dst, int W, int outputRow);
+    const SelectedRowKernels* kernels;
+
+    void operator()(const uint8_t* src, uint8_t* dst, int W, int outputRow) const
+    {
+        row(*kernels, src, dst, W, outputRow);
+    }
+};
+
+// Rows [y0, y1) of Convert422 for one fixed packing, format, matrix and flip:
+// source row y goes to output row y, or H - 1 - y when flipping.
+struct Convert422RowsKernel {
+    void (*rows)(const SelectedRowKernels& k, const uint8_t* src, int srcPitch, uint8_t* dst, int dstPitch,
+                 int W, int H, int y0, int y1, bool flipY);
+    const SelectedRowKernels* kernels;
+    bool flipY;
+
+    void operator()(const uint8_t* src, int srcPitch, uint8_t* dst, int dstPitch,
+                    int W, int H, int y0, int y1) const
+    {
+        rows(*kernels, src, srcPitch, dst, dstPitch, W, H, y0, y1, flipY);
+    }
+};
+
+Convert422RowKernel GetConvert422RowKernel(SourcePacking packing, OutputFormat format, ColorMatrix matrix);
+Convert422RowsKernel GetConvert422RowsKernel(SourcePacking packing, OutputFormat format, bool flipY,
+                                             ColorMatrix matrix);
+
+// Times per-row dispatch (Convert422_Row with a runtime flip, as frames used to
+// be converted) against the per-frame kernels for the 8-bit and a 10-bit
+// packing, single row calls as the field-mode paths make them included, checks
+// that both produce the same frames and returns a human-readable report.
+std::string BenchmarkConversionDispatch(int W, int H, int iterations);
+
+using Unpack422RowKernel = void (*)(const uint8_t* src, uint16_t* dst, int W);
+using UYVY10ToBGRARowKernel = void (*)(const uint16_t* src, uint8_t* dst, int W, int ditherRow);
+using UYVY10ToRGBA16RowKernel = void (*)(const uint16_t* src, uint16_t* dst, int W);
+
+// Best kernel of each stage that does not need more than `path`; never nullptr.
+Unpack422RowKernel GetUnpack422RowKernel(SourcePacking packing, ConversionPath path);
+UYVY10ToBGRARowKernel GetUYVY10ToBGRARowKernel(ConversionPath path, ColorMatrix matrix = ColorMatrix::Bt601Limited);
+UYVY10ToRGBA16RowKernel GetUYVY10ToRGBA16RowKernel(ConversionPath path, ColorMatrix matrix = ColorMatrix::Bt601Limited);
+
+// ---- UYVY -> NV12 (recorder feed) ----
+//
+// NV12: a W x H luma plane followed by an interleaved U,V plane of W/2 pairs x
+// ceil(H/2) rows. Each chroma row averages the chroma of two source rows,
+// rounding up ((a + b + 1) >> 1); an odd last row is paired with itself.
+
+// Converts source rows `src0`/`src1` (W even) into luma rows `dstY0`/`dstY1` and
+// one chroma row `dstUV`.
+using UYVYToNV12RowsKernel = void (*)(const uint8_t* src0, const uint8_t* src1,
+                                      uint8_t* dstY0, uint8_t* dstY1, uint8_t* dstUV, int W);
+
+// Row-pair kernel for `path`, or nullptr when the path was not compiled in.
+UYVYToNV12RowsKernel GetUYVYToNV12RowsKernel(ConversionPath path);
+
+// Top-down UYVY frame -> NV12 planes with the selected path.
+void UYVY_to_NV12(const uint8_t* src, int srcPitch,
+                  uint8_t* dstY, int dstYPitch, uint8_t* dstUV, int dstUVPitch,
+                  int W, int H);
+
+// Bytes of a tightly packed W x H NV12 frame.
+size_t NV12FrameBytes(int W, int H);
+
+// ---- RGB 4:4:4 -> BGRA (DV inputs carrying RGB) ----
+//
+// No matrix is involved: the components are reordered (PSHUFB / VLD3-VST4 in
+// the SIMD paths) and alpha set to 255, so full-range RGB passes losslessly.
+// Limited-range RGB (16..235) is expanded to 0..255 per component as
+// (max(v - 16, 0) * kRgbLimitedScale + 128) >> 8, clamped, the luma scale of
+// the limited-range matrices.
+
+// The VHD_BUFFERPACKING RGB layouts the capture path understands.
+enum class RgbPacking {
+    RGB24,              // VHD_BUFPACK_VIDEO_RGB_24: R, G, B
+    RGB32,              // VHD_BUFPACK_VIDEO_RGB_32: R, G, B, padding
+    Count
+};
+
+constexpr int kRgbLimitedScale = RoundCoefficient(255.0 / 219.0);
+static_assert(HighPart(kRgbLimitedScale) == 1, "the SIMD expansion adds the high part as v itself");
+
+const char* RgbPackingName(RgbPacking packing);
+int RgbBytesPerPixel(RgbPacking packing);
+
+// Converts `W` pixels of one RGB row to BGRA.
+using RgbRowKernel = void (*)(const uint8_t* src, uint8_t* dst, int W);
+
+// Best kernel that does not need more than `path`; never nullptr.
+RgbRowKernel GetRgbRowKernel(RgbPacking packing, bool limitedRange, ConversionPath path);
+
+// RGB frame -> BGRA, optional vertical flip, using the selected path.
+void RGB_to_BGRA(RgbPacking packing, bool limitedRange,
+                 const uint8_t* src, int srcPitch, uint8_t* dst, int dstPitch,
+                 int W, int H, bool flipY);
+
+// Converts a synthetic W x H frame `iterations` times with every supported path,
+// checks each against the scalar reference and returns a human-readable report
+// (one line per path, in Mpixels/s). The 10/16-bit packings are measured with
+// both output formats next to the 8-bit path, and UYVY -> NV12 and RGB -> BGRA
+// per path.
+std::string BenchmarkConversionPaths(int W, int H, int iterations);
+
+// Converts every UYVY code combination with each matrix and compares the result
+// with the conversion evaluated in double precision from the recommendation's
+// luma weights (max/mean error in 8-bit code values), then times each matrix
+// against BT.601 limited, the matrix every stream used to be converted with,
+// on a synthetic W x H frame. Returns a human-readable report.
+std::string BenchmarkColorMatrices(int W, int H, int iterations);
+
+// Per-ISA row kernels (defined in pixel_convert_<isa>.cpp). The matrix kernels
+// are instantiated for every ColorMatrix in their translation unit.
+template <ColorMatrix M> void UYVY_to_BGRA_Row_Scalar(const uint8_t* src, uint8_t* dst, int W);
+#if defined(UNITYDELTACAST_ARCH_X86)
+template <ColorMatrix M> void UYVY_to_BGRA_Row_SSE2(const uint8_t* src, uint8_t* dst, int W);
+template <ColorMatrix M> void UYVY_to_BGRA_Row_SSSE3(const uint8_t* src, uint8_t* dst, int W);
+template <ColorMatrix M> void UYVY_to_BGRA_Row_AVX2(const uint8_t* src, uint8_t* dst, int W);
+#endif
+#if defined(UNITYDELTACAST_ARCH_NEON)
+template <ColorMatrix M> void UYVY_to_BGRA_Row_NEON(const uint8_t* src, uint8_t* dst, int W);
+#endif
+
+void Unpack_UYVY8_Row_Scalar(const uint8_t* src, uint16_t* dst, int W);
+void Unpack_YUV422_10_Row_Scalar(const uint8_t* src, uint16_t* dst, int W);
+void Unpack_YUV422_10_BigEnd_Row_Scalar(const uint8_t* src, uint16_t* dst, int W);
+void Unpack_YUV422_16_Row_Scalar(const uint8_t* src, uint16_t* dst, int W);
+template <ColorMatrix M> void UYVY10_to_BGRA_Row_Scalar(const uint16_t* src, uint8_t* dst, int W, int ditherRow);
+template <ColorMatrix M> void UYVY10_to_RGBA16_Row_Scalar(const uint16_t* src, uint16_t* dst, int W);
+#if defined(UNITYDELTACAST_ARCH_X86)
+void Unpack_UYVY8_Row_SSE2(const uint8_t* src, uint16_t* dst, int W);
+void Unpack_YUV422_16_Row_SSE2(const uint8_t* src, uint16_t* dst, int W);
+void Unpack_YUV422_10_Row_SSSE3(const uint8_t* src, uint16_t* dst, int W);
+void Unpack_YUV422_10_BigEnd_Row_SSSE3(const uint8_t* src, uint16_t* dst, int W);
+template <ColorMatrix M> void UYVY10_to_BGRA_Row_SSE2(const uint16_t* src, uint8_t* dst, int W, int ditherRow);
+template <ColorMatrix M> void UYVY10_to_RGBA16_Row_SSE2(const uint16_t* src, uint16_t* dst, int W);
+#endif
+
+void UYVY_to_NV12_Rows_Scalar(const uint8_t* src0, const uint8_t* src1,
+                              uint8_t* dstY0, uint8_t* dstY1, uint8_t* dstUV, int W);
+#if defined(UNITYDELTACAST_ARCH_X86)
+void UYVY_to_NV12_Rows_SSE2(const uint8_t* src0, const uint8_t* src1,
+                            uint8_t* dstY0, uint8_t* dstY1, uint8_t* dstUV, int W);
+void UYVY_to_NV12_Rows_AVX2(const uint8_t* src0, const uint8_t* src1,
+                            uint8_t* dstY0, uint8_t* dstY1, uint8_t* dstUV, int W);
+#endif
+#if defined(UNITYDELTACAST_ARCH_NEON)
+void UYVY_to_NV12_Rows_NEON(const uint8_t* src0, const uint8_t* src1,
+                            uint8_t* dstY0, uint8_t* dstY1, uint8_t* dstUV, int W);
+#endif
+
+// Instantiated for both ranges (LimitedRange = expand 16..235).
+template <bool LimitedRange> void RGB24_to_BGRA_Row_Scalar(const uint8_t* src, uint8_t* dst, int W);
+template <bool LimitedRange> void RGB32_to_BGRA_Row_Scalar(const uint8_t* src, uint8_t* dst, int W);
+#if defined(UNITYDELTACAST_ARCH_X86)
+template <bool LimitedRange> void RGB24_to_BGRA_Row_SSSE3(const uint8_t* src, uint8_t* dst, int W);
+template <bool LimitedRange> void RGB32_to_BGRA_Row_SSSE3(const uint8_t* src, uint8_t* dst, int W);
+template <bool LimitedRange> void RGB24_to_BGRA_Row_AVX2(const uint8_t* src, uint8_t* dst, int W);
+template <bool LimitedRange> void RGB32_to_BGRA_Row_AVX2(const uint8_t* src, uint8_t* dst, int W);
+#endif
+#if defined(UNITYDELTACAST_ARCH_NEON)
+template <bool LimitedRange> void RGB24_to_BGRA_Row_NEON(const uint8_t* src, uint8_t* dst, int W);
+template <bool LimitedRange> void RGB32_to_BGRA_Row_NEON(const uint8_t* src, uint8_t* dst, int W);
+#endif
+
+// 4x4 ordered-dither thresholds for the 10 -> 8 bit reduction, in units of the
+// two dropped bits' fixed-point weight (see UYVY10_to_BGRA_Row_Scalar).
+constexpr int kBayer4x4[4][4] = {
+    {  0,  8,  2, 10 },
+    { 12,  4, 14,  6 },
+    {  3, 11,  1,  9 },
+    { 15,  7, 13,  5 },
+};
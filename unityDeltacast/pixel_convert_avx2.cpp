@@ -0,0 +1,184 @@
+#include "pixel_convert.hpp"
+
+#if defined(UNITYDELTACAST_ARCH_X86)
+
+#include <immintrin.h>
+
+// 16 pixels per iteration. All arithmetic stays inside 128-bit lanes, exactly as
+// in the SSSE3 kernel; only the final store needs a cross-lane permute.
+template <ColorMatrix M>
+void UYVY_to_BGRA_Row_AVX2(const uint8_t* src, uint8_t* dst, int W)
+{
+    constexpr YuvToRgbMatrix m = YuvToRgb(M);
+
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i lumaOffset = _mm256_set1_epi16(int16_t(m.lumaOffset));
+    const __m256i chromaBias = _mm256_set1_epi16(128);
+    const __m256i rounding = _mm256_set1_epi16(128);
+    const __m256i alpha16 = _mm256_set1_epi16(255);
+
+    const __m256i shufY = _mm256_setr_epi8(
+        1, -1, 3, -1, 5, -1, 7, -1, 9, -1, 11, -1, 13, -1, 15, -1,
+        1, -1, 3, -1, 5, -1, 7, -1, 9, -1, 11, -1, 13, -1, 15, -1);
+    const __m256i shufU = _mm256_setr_epi8(
+        0, -1, 0, -1, 4, -1, 4, -1, 8, -1, 8, -1, 12, -1, 12, -1,
+        0, -1, 0, -1, 4, -1, 4, -1, 8, -1, 8, -1, 12, -1, 12, -1);
+    const __m256i shufV = _mm256_setr_epi8(
+        2, -1, 2, -1, 6, -1, 6, -1, 10, -1, 10, -1, 14, -1, 14, -1,
+        2, -1, 2, -1, 6, -1, 6, -1, 10, -1, 10, -1, 14, -1, 14, -1);
+
+    const __m256i yHi = _mm256_set1_epi16(int16_t(HighPart(m.y)));
+    const __m256i yLo = _mm256_set1_epi16(int16_t(LowPart(m.y)));
+    const __m256i rvHi = _mm256_set1_epi16(int16_t(HighPart(m.rv)));
+    const __m256i rvLo = _mm256_set1_epi16(int16_t(LowPart(m.rv)));
+    const __m256i guHi = _mm256_set1_epi16(int16_t(HighPart(m.gu)));
+    const __m256i guLo = _mm256_set1_epi16(int16_t(LowPart(m.gu)));
+    const __m256i gvHi = _mm256_set1_epi16(int16_t(HighPart(m.gv)));
+    const __m256i gvLo = _mm256_set1_epi16(int16_t(LowPart(m.gv)));
+    const __m256i buHi = _mm256_set1_epi16(int16_t(HighPart(m.bu)));
+    const __m256i buLo = _mm256_set1_epi16(int16_t(LowPart(m.bu)));
+
+    int x = 0;
+    for (; x + 16 <= W; x += 16) {
+        const __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + x * 2));
+
+        const __m256i c = _mm256_max_epi16(_mm256_sub_epi16(_mm256_shuffle_epi8(s, shufY), lumaOffset), zero);
+        const __m256i u = _mm256_sub_epi16(_mm256_shuffle_epi8(s, shufU), chromaBias);
+        const __m256i v = _mm256_sub_epi16(_mm256_shuffle_epi8(s, shufV), chromaBias);
+
+        const __m256i yFull = _mm256_mullo_epi16(c, yHi);
+        const __m256i yFrac = _mm256_add_epi16(_mm256_mullo_epi16(c, yLo), rounding);
+
+        __m256i r = _mm256_add_epi16(yFull, _mm256_mullo_epi16(v, rvHi));
+        r = _mm256_add_epi16(r, _mm256_srai_epi16(_mm256_add_epi16(yFrac, _mm256_mullo_epi16(v, rvLo)), 8));
+
+        __m256i g = _mm256_sub_epi16(_mm256_sub_epi16(yFull, _mm256_mullo_epi16(u, guHi)), _mm256_mullo_epi16(v, gvHi));
+        g = _mm256_add_epi16(g, _mm256_srai_epi16(
+            _mm256_sub_epi16(_mm256_sub_epi16(yFrac, _mm256_mullo_epi16(u, guLo)), _mm256_mullo_epi16(v, gvLo)), 8));
+
+        __m256i b = _mm256_add_epi16(yFull, _mm256_mullo_epi16(u, buHi));
+        b = _mm256_add_epi16(b, _mm256_srai_epi16(_mm256_add_epi16(yFrac, _mm256_mullo_epi16(u, buLo)), 8));
+
+        const __m256i bg = _mm256_packus_epi16(b, g);
+        const __m256i ra = _mm256_packus_epi16(r, alpha16);
+        const __m256i br = _mm256_unpacklo_epi8(bg, ra);
+        const __m256i ga = _mm256_unpackhi_epi8(bg, ra);
+        const __m256i lo = _mm256_unpacklo_epi8(br, ga);   // pixels 0-3 | 8-11
+        const __m256i hi = _mm256_unpackhi_epi8(br, ga);   // pixels 4-7 | 12-15
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + x * 4), _mm256_permute2x128_si256(lo, hi, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + x * 4 + 32), _mm256_permute2x128_si256(lo, hi, 0x31));
+    }
+
+    if (x < W) {
+        UYVY_to_BGRA_Row_Scalar<M>(src + x * 2, dst + x * 4, W - x);
+    }
+}
+
+// 32 pixels per iteration, the SSE2 kernel on 256-bit registers. packus works per
+// 128-bit lane, so each result is put back in order with one 64-bit permute.
+void UYVY_to_NV12_Rows_AVX2(const uint8_t* src0, const uint8_t* src1,
+                            uint8_t* dstY0, uint8_t* dstY1, uint8_t* dstUV, int W)
+{
+    const __m256i lowBytes = _mm256_set1_epi16(0x00FF);
+
+    int x = 0;
+    for (; x + 32 <= W; x += 32) {
+        const __m256i a0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src0 + x * 2));
+        const __m256i a1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src0 + x * 2 + 32));
+        const __m256i b0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src1 + x * 2));
+        const __m256i b1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src1 + x * 2 + 32));
+
+        const __m256i ya = _mm256_packus_epi16(_mm256_srli_epi16(a0, 8), _mm256_srli_epi16(a1, 8));
+        const __m256i yb = _mm256_packus_epi16(_mm256_srli_epi16(b0, 8), _mm256_srli_epi16(b1, 8));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dstY0 + x), _mm256_permute4x64_epi64(ya, 0xD8));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dstY1 + x), _mm256_permute4x64_epi64(yb, 0xD8));
+
+        const __m256i c0 = _mm256_and_si256(_mm256_avg_epu8(a0, b0), lowBytes);
+        const __m256i c1 = _mm256_and_si256(_mm256_avg_epu8(a1, b1), lowBytes);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dstUV + x),
+            _mm256_permute4x64_epi64(_mm256_packus_epi16(c0, c1), 0xD8));
+    }
+
+    if (x < W) {
+        UYVY_to_NV12_Rows_SSE2(src0 + x * 2, src1 + x * 2, dstY0 + x, dstY1 + x, dstUV + x, W - x);
+    }
+}
+
+// The SSSE3 RGB kernels on 256-bit registers; PSHUFB and the pack/unpack of
+// the range expansion work per 128-bit lane, which keeps the pixel order.
+template <bool LimitedRange>
+static inline __m256i ExpandRgbRange(__m256i v)
+{
+    if (!LimitedRange) return v;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i low = _mm256_set1_epi16(int16_t(LowPart(kRgbLimitedScale)));
+    const __m256i rounding = _mm256_set1_epi16(128);
+    const __m256i c = _mm256_subs_epu8(v, _mm256_set1_epi8(16));
+    auto expand = [&](__m256i w) {
+        return _mm256_add_epi16(w, _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(w, low), rounding), 8));
+    };
+    return _mm256_packus_epi16(expand(_mm256_unpacklo_epi8(c, zero)), expand(_mm256_unpackhi_epi8(c, zero)));
+}
+
+// 16 pixels (48 bytes) per iteration: the four 12-byte groups are lined up as in
+// the SSSE3 kernel and paired into two registers.
+template <bool LimitedRange>
+void RGB24_to_BGRA_Row_AVX2(const uint8_t* src, uint8_t* dst, int W)
+{
+    const __m256i shuf = _mm256_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1,
+                                          2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+    const __m256i alpha = _mm256_set1_epi32(int(0xFF000000u));
+    auto store = [&](uint8_t* d, __m128i lo, __m128i hi) {
+        const __m256i groups = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+        const __m256i bgra = _mm256_or_si256(_mm256_shuffle_epi8(groups, shuf), alpha);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d), ExpandRgbRange<LimitedRange>(bgra));
+    };
+
+    int x = 0;
+    for (; x + 16 <= W; x += 16) {
+        const uint8_t* s = src + x * 3;
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 16));
+        const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 32));
+        store(dst + x * 4, a, _mm_alignr_epi8(b, a, 12));
+        store(dst + x * 4 + 32, _mm_alignr_epi8(c, b, 8), _mm_srli_si128(c, 4));
+    }
+
+    if (x < W) {
+        RGB24_to_BGRA_Row_Scalar<LimitedRange>(src + x * 3, dst + x * 4, W - x);
+    }
+}
+
+template <bool LimitedRange>
+void RGB32_to_BGRA_Row_AVX2(const uint8_t* src, uint8_t* dst, int W)
+{
+    const __m256i shuf = _mm256_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1,
+                                          2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const __m256i alpha = _mm256_set1_epi32(int(0xFF000000u));
+
+    int x = 0;
+    for (; x + 8 <= W; x += 8) {
+        const __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + x * 4));
+        const __m256i bgra = _mm256_or_si256(_mm256_shuffle_epi8(s, shuf), alpha);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + x * 4), ExpandRgbRange<LimitedRange>(bgra));
+    }
+
+    if (x < W) {
+        RGB32_to_BGRA_Row_SSSE3<LimitedRange>(src + x * 4, dst + x * 4, W - x);
+    }
+}
+
+template void UYVY_to_BGRA_Row_AVX2<ColorMatrix::Bt601Limited>(const uint8_t*, uint8_t*, int);
+template void UYVY_to_BGRA_Row_AVX2<ColorMatrix::Bt601Full>(const uint8_t*, uint8_t*, int);
+template void UYVY_to_BGRA_Row_AVX2<ColorMatrix::Bt709Limited>(const uint8_t*, uint8_t*, int);
+template void UYVY_to_BGRA_Row_AVX2<ColorMatrix::Bt709Full>(const uint8_t*, uint8_t*, int);
+template void UYVY_to_BGRA_Row_AVX2<ColorMatrix::Bt2020Limited>(const uint8_t*, uint8_t*, int);
+template void UYVY_to_BGRA_Row_AVX2<ColorMatrix::Bt2020Full>(const uint8_t*, uint8_t*, int);
+
+template void RGB24_to_BGRA_Row_AVX2<false>(const uint8_t*, uint8_t*, int);
+template void RGB24_to_BGRA_Row_AVX2<true>(const uint8_t*, uint8_t*, int);
+template void RGB32_to_BGRA_Row_AVX2<false>(const uint8_t*, uint8_t*, int);
+template void RGB32_to_BGRA_Row_AVX2<true>(const uint8_t*, uint8_t*, int);
+
+#endif
@@ -0,0 +1,163 @@
+#include "pixel_convert.hpp"
+
+#if defined(UNITYDELTACAST_ARCH_NEON)
+
+#include <arm_neon.h>
+
+// 16 pixels per iteration. VLD4 deinterleaves U/Y0/V/Y1 of 8 macropixels, so the
+// even and odd pixels are converted separately against the same chroma and
+// re-interleaved with VZIP before the VST4 store.
+namespace {
+
+struct Rgb16 {
+    int16x8_t r, g, b;
+};
+
+template <ColorMatrix M>
+inline Rgb16 ConvertLane(int16x8_t c, int16x8_t u, int16x8_t v)
+{
+    constexpr YuvToRgbMatrix m = YuvToRgb(M);
+
+    const int16x8_t yFull = vmulq_n_s16(c, int16_t(HighPart(m.y)));
+    const int16x8_t yFrac = vaddq_s16(vmulq_n_s16(c, int16_t(LowPart(m.y))), vdupq_n_s16(128));
+
+    Rgb16 out;
+    out.r = vmlaq_n_s16(yFull, v, int16_t(HighPart(m.rv)));
+    out.r = vaddq_s16(out.r, vshrq_n_s16(vmlaq_n_s16(yFrac, v, int16_t(LowPart(m.rv))), 8));
+
+    out.g = vmlsq_n_s16(vmlsq_n_s16(yFull, u, int16_t(HighPart(m.gu))), v, int16_t(HighPart(m.gv)));
+    out.g = vaddq_s16(out.g, vshrq_n_s16(
+        vmlsq_n_s16(vmlsq_n_s16(yFrac, u, int16_t(LowPart(m.gu))), v, int16_t(LowPart(m.gv))), 8));
+
+    out.b = vmlaq_n_s16(yFull, u, int16_t(HighPart(m.bu)));
+    out.b = vaddq_s16(out.b, vshrq_n_s16(vmlaq_n_s16(yFrac, u, int16_t(LowPart(m.bu))), 8));
+    return out;
+}
+
+inline uint8x16_t Interleave(int16x8_t even, int16x8_t odd)
+{
+    const uint8x8x2_t z = vzip_u8(vqmovun_s16(even), vqmovun_s16(odd));
+    return vcombine_u8(z.val[0], z.val[1]);
+}
+
+} // namespace
+
+template <ColorMatrix M>
+void UYVY_to_BGRA_Row_NEON(const uint8_t* src, uint8_t* dst, int W)
+{
+    const int16x8_t lumaOffset = vdupq_n_s16(int16_t(YuvToRgb(M).lumaOffset));
+    const int16x8_t chromaBias = vdupq_n_s16(128);
+    const int16x8_t zero = vdupq_n_s16(0);
+
+    int x = 0;
+    for (; x + 16 <= W; x += 16) {
+        const uint8x8x4_t s = vld4_u8(src + x * 2);   // U, Y0, V, Y1
+
+        const int16x8_t u = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(s.val[0])), chromaBias);
+        const int16x8_t v = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(s.val[2])), chromaBias);
+        const int16x8_t c0 = vmaxq_s16(vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(s.val[1])), lumaOffset), zero);
+        const int16x8_t c1 = vmaxq_s16(vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(s.val[3])), lumaOffset), zero);
+
+        const Rgb16 even = ConvertLane<M>(c0, u, v);
+        const Rgb16 odd = ConvertLane<M>(c1, u, v);
+
+        uint8x16x4_t out;
+        out.val[0] = Interleave(even.b, odd.b);
+        out.val[1] = Interleave(even.g, odd.g);
+        out.val[2] = Interleave(even.r, odd.r);
+        out.val[3] = vdupq_n_u8(255);
+        vst4q_u8(dst + x * 4, out);
+    }
+
+    if (x < W) {
+        UYVY_to_BGRA_Row_Scalar<M>(src + x * 2, dst + x * 4, W - x);
+    }
+}
+
+// 16 pixels per iteration. VLD2 splits each row into the U,V pairs (already in
+// NV12 order) and the luma; VRHADD is the rounding average (a + b + 1) >> 1.
+void UYVY_to_NV12_Rows_NEON(const uint8_t* src0, const uint8_t* src1,
+                            uint8_t* dstY0, uint8_t* dstY1, uint8_t* dstUV, int W)
+{
+    int x = 0;
+    for (; x + 16 <= W; x += 16) {
+        const uint8x16x2_t a = vld2q_u8(src0 + x * 2);
+        const uint8x16x2_t b = vld2q_u8(src1 + x * 2);
+        vst1q_u8(dstY0 + x, a.val[1]);
+        vst1q_u8(dstY1 + x, b.val[1]);
+        vst1q_u8(dstUV + x, vrhaddq_u8(a.val[0], b.val[0]));
+    }
+
+    if (x < W) {
+        UYVY_to_NV12_Rows_Scalar(src0 + x * 2, src1 + x * 2, dstY0 + x, dstY1 + x, dstUV + x, W - x);
+    }
+}
+
+// Limited-range expansion of 16 components, as in the SSSE3 kernels:
+// c + ((c * low + 128) >> 8) with c = max(v - 16, 0), narrowed with saturation.
+template <bool LimitedRange>
+static inline uint8x16_t ExpandRgbRange(uint8x16_t v)
+{
+    if (!LimitedRange) return v;
+    const uint8x16_t c = vqsubq_u8(v, vdupq_n_u8(16));
+    auto expand = [](uint8x8_t half) {
+        const uint16x8_t w = vmovl_u8(half);
+        const uint16x8_t frac = vmlaq_n_u16(vdupq_n_u16(128), w, uint16_t(LowPart(kRgbLimitedScale)));
+        return vqmovn_u16(vaddq_u16(w, vshrq_n_u16(frac, 8)));
+    };
+    return vcombine_u8(expand(vget_low_u8(c)), expand(vget_high_u8(c)));
+}
+
+// 16 pixels per iteration: VLD3/VLD4 deinterleave the components, VST4 writes
+// them back as B G R A.
+template <bool LimitedRange>
+void RGB24_to_BGRA_Row_NEON(const uint8_t* src, uint8_t* dst, int W)
+{
+    int x = 0;
+    for (; x + 16 <= W; x += 16) {
+        const uint8x16x3_t rgb = vld3q_u8(src + x * 3);
+        uint8x16x4_t bgra;
+        bgra.val[0] = ExpandRgbRange<LimitedRange>(rgb.val[2]);
+        bgra.val[1] = ExpandRgbRange<LimitedRange>(rgb.val[1]);
+        bgra.val[2] = ExpandRgbRange<LimitedRange>(rgb.val[0]);
+        bgra.val[3] = vdupq_n_u8(255);
+        vst4q_u8(dst + x * 4, bgra);
+    }
+
+    if (x < W) {
+        RGB24_to_BGRA_Row_Scalar<LimitedRange>(src + x * 3, dst + x * 4, W - x);
+    }
+}
+
+template <bool LimitedRange>
+void RGB32_to_BGRA_Row_NEON(const uint8_t* src, uint8_t* dst, int W)
+{
+    int x = 0;
+    for (; x + 16 <= W; x += 16) {
+        const uint8x16x4_t rgbx = vld4q_u8(src + x * 4);
+        uint8x16x4_t bgra;
+        bgra.val[0] = ExpandRgbRange<LimitedRange>(rgbx.val[2]);
+        bgra.val[1] = ExpandRgbRange<LimitedRange>(rgbx.val[1]);
+        bgra.val[2] = ExpandRgbRange<LimitedRange>(rgbx.val[0]);
+        bgra.val[3] = vdupq_n_u8(255);
+        vst4q_u8(dst + x * 4, bgra);
+    }
+
+    if (x < W) {
+        RGB32_to_BGRA_Row_Scalar<LimitedRange>(src + x * 4, dst + x * 4, W - x);
+    }
+}
+
+template void UYVY_to_BGRA_Row_NEON<ColorMatrix::Bt601Limited>(const uint8_t*, uint8_t*, int);
+template void UYVY_to_BGRA_Row_NEON<ColorMatrix::Bt601Full>(const uint8_t*, uint8_t*, int);
+template void UYVY_to_BGRA_Row_NEON<ColorMatrix::Bt709Limited>(const uint8_t*, uint8_t*, int);
+template void UYVY_to_BGRA_Row_NEON<ColorMatrix::Bt709Full>(const uint8_t*, uint8_t*, int);
+template void UYVY_to_BGRA_Row_NEON<ColorMatrix::Bt2020Limited>(const uint8_t*, uint8_t*, int);
+template void UYVY_to_BGRA_Row_NEON<ColorMatrix::Bt2020Full>(const uint8_t*, uint8_t*, int);
+
+template void RGB24_to_BGRA_Row_NEON<false>(const uint8_t*, uint8_t*, int);
+template void RGB24_to_BGRA_Row_NEON<true>(const uint8_t*, uint8_t*, int);
+template void RGB32_to_BGRA_Row_NEON<false>(const uint8_t*, uint8_t*, int);
+template void RGB32_to_BGRA_Row_NEON<true>(const uint8_t*, uint8_t*, int);
+
+#endif
@@ -0,0 +1,285 @@
+#include "pixel_convert.hpp"
+
+#if defined(UNITYDELTACAST_ARCH_X86)
+
+#include <emmintrin.h>
+
+// 8 pixels per iteration. Chroma is widened to one 16-bit lane per pixel and the
+// matrix is evaluated with the 16-bit high/low coefficient split (see
+// pixel_convert.hpp), so no 32-bit intermediates are needed.
+template <ColorMatrix M>
+void UYVY_to_BGRA_Row_SSE2(const uint8_t* src, uint8_t* dst, int W)
+{
+    constexpr YuvToRgbMatrix m = YuvToRgb(M);
+
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i lumaOffset = _mm_set1_epi16(int16_t(m.lumaOffset));
+    const __m128i chromaBias = _mm_set1_epi16(128);
+    const __m128i rounding = _mm_set1_epi16(128);
+    const __m128i lowByte32 = _mm_set1_epi32(0xFF);
+    const __m128i alpha = _mm_set1_epi8(char(0xFF));
+
+    const __m128i yHi = _mm_set1_epi16(int16_t(HighPart(m.y)));
+    const __m128i yLo = _mm_set1_epi16(int16_t(LowPart(m.y)));
+    const __m128i rvHi = _mm_set1_epi16(int16_t(HighPart(m.rv)));
+    const __m128i rvLo = _mm_set1_epi16(int16_t(LowPart(m.rv)));
+    const __m128i guHi = _mm_set1_epi16(int16_t(HighPart(m.gu)));
+    const __m128i guLo = _mm_set1_epi16(int16_t(LowPart(m.gu)));
+    const __m128i gvHi = _mm_set1_epi16(int16_t(HighPart(m.gv)));
+    const __m128i gvLo = _mm_set1_epi16(int16_t(LowPart(m.gv)));
+    const __m128i buHi = _mm_set1_epi16(int16_t(HighPart(m.bu)));
+    const __m128i buLo = _mm_set1_epi16(int16_t(LowPart(m.bu)));
+
+    int x = 0;
+    for (; x + 8 <= W; x += 8) {
+        const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x * 2));
+
+        // Y: odd bytes. U/V: bytes 0 and 2 of every 32-bit macropixel, copied
+        // into both 16-bit halves so each pixel owns its chroma sample.
+        __m128i c = _mm_sub_epi16(_mm_srli_epi16(s, 8), lumaOffset);
+        c = _mm_max_epi16(c, zero);
+
+        __m128i u = _mm_and_si128(s, lowByte32);
+        u = _mm_or_si128(u, _mm_slli_epi32(u, 16));
+        u = _mm_sub_epi16(u, chromaBias);
+
+        __m128i v = _mm_and_si128(_mm_srli_epi32(s, 16), lowByte32);
+        v = _mm_or_si128(v, _mm_slli_epi32(v, 16));
+        v = _mm_sub_epi16(v, chromaBias);
+
+        const __m128i yFull = _mm_mullo_epi16(c, yHi);
+        const __m128i yFrac = _mm_add_epi16(_mm_mullo_epi16(c, yLo), rounding);
+
+        __m128i r = _mm_add_epi16(yFull, _mm_mullo_epi16(v, rvHi));
+        r = _mm_add_epi16(r, _mm_srai_epi16(_mm_add_epi16(yFrac, _mm_mullo_epi16(v, rvLo)), 8));
+
+        __m128i g = _mm_sub_epi16(_mm_sub_epi16(yFull, _mm_mullo_epi16(u, guHi)), _mm_mullo_epi16(v, gvHi));
+        g = _mm_add_epi16(g, _mm_srai_epi16(
+            _mm_sub_epi16(_mm_sub_epi16(yFrac, _mm_mullo_epi16(u, guLo)), _mm_mullo_epi16(v, gvLo)), 8));
+
+        __m128i b = _mm_add_epi16(yFull, _mm_mullo_epi16(u, buHi));
+        b = _mm_add_epi16(b, _mm_srai_epi16(_mm_add_epi16(yFrac, _mm_mullo_epi16(u, buLo)), 8));
+
+        // Saturate to 8 bits and interleave to B G R A.
+        const __m128i b8 = _mm_packus_epi16(b, b);
+        const __m128i g8 = _mm_packus_epi16(g, g);
+        const __m128i r8 = _mm_packus_epi16(r, r);
+        const __m128i bg = _mm_unpacklo_epi8(b8, g8);
+        const __m128i ra = _mm_unpacklo_epi8(r8, alpha);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 4), _mm_unpacklo_epi16(bg, ra));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 4 + 16), _mm_unpackhi_epi16(bg, ra));
+    }
+
+    if (x < W) {
+        UYVY_to_BGRA_Row_Scalar<M>(src + x * 2, dst + x * 4, W - x);
+    }
+}
+
+void Unpack_UYVY8_Row_SSE2(const uint8_t* src, uint16_t* dst, int W)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const int n = W * 2;
+
+    int k = 0;
+    for (; k + 16 <= n; k += 16) {
+        const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + k));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + k), _mm_slli_epi16(_mm_unpacklo_epi8(s, zero), 2));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + k + 8), _mm_slli_epi16(_mm_unpackhi_epi8(s, zero), 2));
+    }
+
+    if (k < n) {
+        Unpack_UYVY8_Row_Scalar(src + k, dst + k, (n - k) / 2);
+    }
+}
+
+void Unpack_YUV422_16_Row_SSE2(const uint8_t* src, uint16_t* dst, int W)
+{
+    const int n = W * 2;
+
+    int k = 0;
+    for (; k + 8 <= n; k += 8) {
+        const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + k * 2));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + k), _mm_srli_epi16(s, 6));
+    }
+
+    if (k < n) {
+        Unpack_YUV422_16_Row_Scalar(src + k * 2, dst + k, (n - k) / 2);
+    }
+}
+
+// 16 pixels per iteration: luma is the odd bytes, and the even bytes are the
+// U,V pairs already in NV12 order, averaged across the two rows with pavgb.
+void UYVY_to_NV12_Rows_SSE2(const uint8_t* src0, const uint8_t* src1,
+                            uint8_t* dstY0, uint8_t* dstY1, uint8_t* dstUV, int W)
+{
+    const __m128i lowBytes = _mm_set1_epi16(0x00FF);
+
+    int x = 0;
+    for (; x + 16 <= W; x += 16) {
+        const __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src0 + x * 2));
+        const __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src0 + x * 2 + 16));
+        const __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src1 + x * 2));
+        const __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src1 + x * 2 + 16));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dstY0 + x),
+            _mm_packus_epi16(_mm_srli_epi16(a0, 8), _mm_srli_epi16(a1, 8)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dstY1 + x),
+            _mm_packus_epi16(_mm_srli_epi16(b0, 8), _mm_srli_epi16(b1, 8)));
+
+        const __m128i c0 = _mm_and_si128(_mm_avg_epu8(a0, b0), lowBytes);
+        const __m128i c1 = _mm_and_si128(_mm_avg_epu8(a1, b1), lowBytes);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dstUV + x), _mm_packus_epi16(c0, c1));
+    }
+
+    if (x < W) {
+        UYVY_to_NV12_Rows_Scalar(src0 + x * 2, src1 + x * 2, dstY0 + x, dstY1 + x, dstUV + x, W - x);
+    }
+}
+
+namespace {
+
+// Fixed-point R, G, B sums (10 fractional bits, see UYVY10_to_BGRA_Row_Scalar)
+// of 8 pixels as two vectors of four 32-bit lanes each.
+struct Rgb32x8 {
+    __m128i r[2], g[2], b[2];
+};
+
+// 8 pixels = 16 UYVY10 components. PMADDWD evaluates two matrix terms per
+// 32-bit lane, so each output needs one (R, B) or two (G) multiply-adds.
+template <ColorMatrix M>
+inline Rgb32x8 UYVY10ToRgb32(const uint16_t* s)
+{
+    constexpr YuvToRgbMatrix m = YuvToRgb(M);
+
+    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));        // U0 Y0 V0 Y1 U1 Y2 V1 Y3
+    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 8));
+
+    // Components are 10-bit, so the signed 32 -> 16 packs never saturate.
+    const __m128i y = _mm_packs_epi32(_mm_srli_epi32(a, 16), _mm_srli_epi32(b, 16));
+    __m128i uv = _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(a, 16), 16),
+                                 _mm_srai_epi32(_mm_slli_epi32(b, 16), 16));        // U0 V0 U1 V1 ...
+    uv = _mm_sub_epi16(uv, _mm_set1_epi16(512));
+
+    const __m128i c = _mm_max_epi16(_mm_sub_epi16(y, _mm_set1_epi16(int16_t(m.lumaOffset * 4))), _mm_setzero_si128());
+    const __m128i u = _mm_shufflehi_epi16(_mm_shufflelo_epi16(uv, _MM_SHUFFLE(2, 2, 0, 0)), _MM_SHUFFLE(2, 2, 0, 0));
+    const __m128i v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(uv, _MM_SHUFFLE(3, 3, 1, 1)), _MM_SHUFFLE(3, 3, 1, 1));
+
+    const __m128i kR = _mm_set1_epi32(int((uint32_t(uint16_t(m.rv)) << 16) | uint16_t(m.y)));
+    const __m128i kGu = _mm_set1_epi32(int((uint32_t(uint16_t(-m.gu)) << 16) | uint16_t(m.y)));
+    const __m128i kGv = _mm_set1_epi32(int(uint16_t(-m.gv)));
+    const __m128i kB = _mm_set1_epi32(int((uint32_t(uint16_t(m.bu)) << 16) | uint16_t(m.y)));
+    const __m128i zero = _mm_setzero_si128();
+
+    Rgb32x8 out;
+    const __m128i cv[2] = { _mm_unpacklo_epi16(c, v), _mm_unpackhi_epi16(c, v) };
+    const __m128i cu[2] = { _mm_unpacklo_epi16(c, u), _mm_unpackhi_epi16(c, u) };
+    const __m128i v0[2] = { _mm_unpacklo_epi16(v, zero), _mm_unpackhi_epi16(v, zero) };
+    for (int h = 0; h < 2; ++h) {
+        out.r[h] = _mm_madd_epi16(cv[h], kR);
+        out.g[h] = _mm_add_epi32(_mm_madd_epi16(cu[h], kGu), _mm_madd_epi16(v0[h], kGv));
+        out.b[h] = _mm_madd_epi16(cu[h], kB);
+    }
+    return out;
+}
+
+} // namespace
+
+// 8 pixels per iteration; x stays a multiple of 4, so one dither vector covers
+// every group of four pixels in the row.
+template <ColorMatrix M>
+void UYVY10_to_BGRA_Row_SSE2(const uint16_t* src, uint8_t* dst, int W, int ditherRow)
+{
+    const int* bayer = kBayer4x4[ditherRow & 3];
+    const __m128i dither = _mm_setr_epi32(bayer[0] * 64 + 32, bayer[1] * 64 + 32,
+                                          bayer[2] * 64 + 32, bayer[3] * 64 + 32);
+    const __m128i alpha = _mm_set1_epi8(char(0xFF));
+
+    auto to8 = [&](const __m128i v[2]) {
+        const __m128i lo = _mm_srai_epi32(_mm_add_epi32(v[0], dither), 10);
+        const __m128i hi = _mm_srai_epi32(_mm_add_epi32(v[1], dither), 10);
+        const __m128i v16 = _mm_packs_epi32(lo, hi);
+        return _mm_packus_epi16(v16, v16);
+    };
+
+    int x = 0;
+    for (; x + 8 <= W; x += 8) {
+        const Rgb32x8 rgb = UYVY10ToRgb32<M>(src + x * 2);
+
+        const __m128i bg = _mm_unpacklo_epi8(to8(rgb.b), to8(rgb.g));
+        const __m128i ra = _mm_unpacklo_epi8(to8(rgb.r), alpha);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 4), _mm_unpacklo_epi16(bg, ra));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 4 + 16), _mm_unpackhi_epi16(bg, ra));
+    }
+
+    if (x < W) {
+        // x is a multiple of 8, so the scalar tail sees the same dither phase.
+        UYVY10_to_BGRA_Row_Scalar<M>(src + x * 2, dst + x * 4, W - x, ditherRow);
+    }
+}
+
+template <ColorMatrix M>
+void UYVY10_to_RGBA16_Row_SSE2(const uint16_t* src, uint16_t* dst, int W)
+{
+    const __m128i rounding = _mm_set1_epi32(512);
+    const __m128i bias32 = _mm_set1_epi32(32768);
+    const __m128i bias16 = _mm_set1_epi16(int16_t(0x8000));
+    const __m128i alpha = _mm_set1_epi16(-1);
+
+    // clamp16((v*257 + 512) >> 10); the unsigned 16-bit saturation is done with
+    // a signed pack on values biased by -32768.
+    auto to16 = [&](const __m128i v[2]) {
+        __m128i lo = _mm_add_epi32(_mm_add_epi32(_mm_slli_epi32(v[0], 8), v[0]), rounding);
+        __m128i hi = _mm_add_epi32(_mm_add_epi32(_mm_slli_epi32(v[1], 8), v[1]), rounding);
+        lo = _mm_sub_epi32(_mm_srai_epi32(lo, 10), bias32);
+        hi = _mm_sub_epi32(_mm_srai_epi32(hi, 10), bias32);
+        return _mm_xor_si128(_mm_packs_epi32(lo, hi), bias16);
+    };
+
+    int x = 0;
+    for (; x + 8 <= W; x += 8) {
+        const Rgb32x8 rgb = UYVY10ToRgb32<M>(src + x * 2);
+        const __m128i r = to16(rgb.r);
+        const __m128i g = to16(rgb.g);
+        const __m128i b = to16(rgb.b);
+
+        const __m128i rgLo = _mm_unpacklo_epi16(r, g);
+        const __m128i rgHi = _mm_unpackhi_epi16(r, g);
+        const __m128i baLo = _mm_unpacklo_epi16(b, alpha);
+        const __m128i baHi = _mm_unpackhi_epi16(b, alpha);
+
+        __m128i* d = reinterpret_cast<__m128i*>(dst + x * 4);
+        _mm_storeu_si128(d + 0, _mm_unpacklo_epi32(rgLo, baLo));
+        _mm_storeu_si128(d + 1, _mm_unpackhi_epi32(rgLo, baLo));
+        _mm_storeu_si128(d + 2, _mm_unpacklo_epi32(rgHi, baHi));
+        _mm_storeu_si128(d + 3, _mm_unpackhi_epi32(rgHi, baHi));
+    }
+
+    if (x < W) {
+        UYVY10_to_RGBA16_Row_Scalar<M>(src + x * 2, dst + x * 4, W - x);
+    }
+}
+
+template void UYVY_to_BGRA_Row_SSE2<ColorMatrix::Bt601Limited>(const uint8_t*, uint8_t*, int);
+template void UYVY_to_BGRA_Row_SSE2<ColorMatrix::Bt601Full>(const uint8_t*, uint8_t*, int);
+template void UYVY_to_BGRA_Row_SSE2<ColorMatrix::Bt709Limited>(const uint8_t*, uint8_t*, int);
+template void UYVY_to_BGRA_Row_SSE2<ColorMatrix::Bt709Full>(const uint8_t*, uint8_t*, int);
+template void UYVY_to_BGRA_Row_SSE2<ColorMatrix::Bt2020Limited>(const uint8_t*, uint8_t*, int);
+template void UYVY_to_BGRA_Row_SSE2<ColorMatrix::Bt2020Full>(const uint8_t*, uint8_t*, int);
+
+template void UYVY10_to_BGRA_Row_SSE2<ColorMatrix::Bt601Limited>(const uint16_t*, uint8_t*, int, int);
+template void UYVY10_to_BGRA_Row_SSE2<ColorMatrix::Bt601Full>(const uint16_t*, uint8_t*, int, int);
+template void UYVY10_to_BGRA_Row_SSE2<ColorMatrix::Bt709Limited>(const uint16_t*, uint8_t*, int, int);
+template void UYVY10_to_BGRA_Row_SSE2<ColorMatrix::Bt709Full>(const uint16_t*, uint8_t*, int, int);
+template void UYVY10_to_BGRA_Row_SSE2<ColorMatrix::Bt2020Limited>(const uint16_t*, uint8_t*, int, int);
+template void UYVY10_to_BGRA_Row_SSE2<ColorMatrix::Bt2020Full>(const uint16_t*, uint8_t*, int, int);
+
+template void UYVY10_to_RGBA16_Row_SSE2<ColorMatrix::Bt601Limited>(const uint16_t*, uint16_t*, int);
+template void UYVY10_to_RGBA16_Row_SSE2<ColorMatrix::Bt601Full>(const uint16_t*, uint16_t*, int);
+template void UYVY10_to_RGBA16_Row_SSE2<ColorMatrix::Bt709Limited>(const uint16_t*, uint16_t*, int);
+template void UYVY10_to_RGBA16_Row_SSE2<ColorMatrix::Bt709Full>(const uint16_t*, uint16_t*, int);
+template void UYVY10_to_RGBA16_Row_SSE2<ColorMatrix::Bt2020Limited>(const uint16_t*, uint16_t*, int);
+template void UYVY10_to_RGBA16_Row_SSE2<ColorMatrix::Bt2020Full>(const uint16_t*, uint16_t*, int);
+
+#endif
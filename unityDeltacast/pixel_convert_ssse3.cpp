@@ -0,0 +1,212 @@
+#include "pixel_convert.hpp"
+
+#if defined(UNITYDELTACAST_ARCH_X86)
+
+#include <tmmintrin.h>
+
+// Same arithmetic as the SSE2 kernel; PSHUFB replaces the shift/mask/or chains
+// that widen Y, U and V to 16-bit lanes and the unpack ladder of the BGRA store.
+template <ColorMatrix M>
+void UYVY_to_BGRA_Row_SSSE3(const uint8_t* src, uint8_t* dst, int W)
+{
+    constexpr YuvToRgbMatrix m = YuvToRgb(M);
+
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i lumaOffset = _mm_set1_epi16(int16_t(m.lumaOffset));
+    const __m128i chromaBias = _mm_set1_epi16(128);
+    const __m128i rounding = _mm_set1_epi16(128);
+    const __m128i alpha16 = _mm_set1_epi16(255);
+
+    const __m128i shufY = _mm_setr_epi8(1, -1, 3, -1, 5, -1, 7, -1, 9, -1, 11, -1, 13, -1, 15, -1);
+    const __m128i shufU = _mm_setr_epi8(0, -1, 0, -1, 4, -1, 4, -1, 8, -1, 8, -1, 12, -1, 12, -1);
+    const __m128i shufV = _mm_setr_epi8(2, -1, 2, -1, 6, -1, 6, -1, 10, -1, 10, -1, 14, -1, 14, -1);
+
+    const __m128i yHi = _mm_set1_epi16(int16_t(HighPart(m.y)));
+    const __m128i yLo = _mm_set1_epi16(int16_t(LowPart(m.y)));
+    const __m128i rvHi = _mm_set1_epi16(int16_t(HighPart(m.rv)));
+    const __m128i rvLo = _mm_set1_epi16(int16_t(LowPart(m.rv)));
+    const __m128i guHi = _mm_set1_epi16(int16_t(HighPart(m.gu)));
+    const __m128i guLo = _mm_set1_epi16(int16_t(LowPart(m.gu)));
+    const __m128i gvHi = _mm_set1_epi16(int16_t(HighPart(m.gv)));
+    const __m128i gvLo = _mm_set1_epi16(int16_t(LowPart(m.gv)));
+    const __m128i buHi = _mm_set1_epi16(int16_t(HighPart(m.bu)));
+    const __m128i buLo = _mm_set1_epi16(int16_t(LowPart(m.bu)));
+
+    int x = 0;
+    for (; x + 8 <= W; x += 8) {
+        const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x * 2));
+
+        const __m128i c = _mm_max_epi16(_mm_sub_epi16(_mm_shuffle_epi8(s, shufY), lumaOffset), zero);
+        const __m128i u = _mm_sub_epi16(_mm_shuffle_epi8(s, shufU), chromaBias);
+        const __m128i v = _mm_sub_epi16(_mm_shuffle_epi8(s, shufV), chromaBias);
+
+        const __m128i yFull = _mm_mullo_epi16(c, yHi);
+        const __m128i yFrac = _mm_add_epi16(_mm_mullo_epi16(c, yLo), rounding);
+
+        __m128i r = _mm_add_epi16(yFull, _mm_mullo_epi16(v, rvHi));
+        r = _mm_add_epi16(r, _mm_srai_epi16(_mm_add_epi16(yFrac, _mm_mullo_epi16(v, rvLo)), 8));
+
+        __m128i g = _mm_sub_epi16(_mm_sub_epi16(yFull, _mm_mullo_epi16(u, guHi)), _mm_mullo_epi16(v, gvHi));
+        g = _mm_add_epi16(g, _mm_srai_epi16(
+            _mm_sub_epi16(_mm_sub_epi16(yFrac, _mm_mullo_epi16(u, guLo)), _mm_mullo_epi16(v, gvLo)), 8));
+
+        __m128i b = _mm_add_epi16(yFull, _mm_mullo_epi16(u, buHi));
+        b = _mm_add_epi16(b, _mm_srai_epi16(_mm_add_epi16(yFrac, _mm_mullo_epi16(u, buLo)), 8));
+
+        // bg = B0..B7 G0..G7, ra = R0..R7 A0..A7
+        const __m128i bg = _mm_packus_epi16(b, g);
+        const __m128i ra = _mm_packus_epi16(r, alpha16);
+        const __m128i br = _mm_unpacklo_epi8(bg, ra);   // B0 R0 B1 R1 ...
+        const __m128i ga = _mm_unpackhi_epi8(bg, ra);   // G0 A0 G1 A1 ...
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 4), _mm_unpacklo_epi8(br, ga));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 4 + 16), _mm_unpackhi_epi8(br, ga));
+    }
+
+    if (x < W) {
+        UYVY_to_BGRA_Row_Scalar<M>(src + x * 2, dst + x * 4, W - x);
+    }
+}
+
+// Both 10-bit unpackers gather the two bytes holding each component into a
+// 16-bit lane with PSHUFB, then drop the neighbouring bits with a per-lane left
+// shift (PMULLW by a power of two) followed by a uniform right shift by 6.
+
+// 12 pixels (two 16-byte V210 groups, 24 components) per iteration, as three
+// overlapping loads at byte offsets 0, 8 and 16.
+void Unpack_YUV422_10_Row_SSSE3(const uint8_t* src, uint16_t* dst, int W)
+{
+    // Component k of a group sits in word k/3 at bit 10*(k%3), i.e. at byte
+    // 4*(k/3) + k%3 with a bit offset of 0, 2 or 4; multipliers are 1 << (6 - offset).
+    const __m128i shuf0 = _mm_setr_epi8(0, 1, 1, 2, 2, 3, 4, 5, 5, 6, 6, 7, 8, 9, 9, 10);
+    const __m128i shuf1 = _mm_setr_epi8(2, 3, 4, 5, 5, 6, 6, 7, 8, 9, 9, 10, 10, 11, 12, 13);
+    const __m128i shuf2 = _mm_setr_epi8(5, 6, 6, 7, 8, 9, 9, 10, 10, 11, 12, 13, 13, 14, 14, 15);
+    const __m128i mul0 = _mm_setr_epi16(64, 16, 4, 64, 16, 4, 64, 16);
+    const __m128i mul1 = _mm_setr_epi16(4, 64, 16, 4, 64, 16, 4, 64);
+    const __m128i mul2 = _mm_setr_epi16(16, 4, 64, 16, 4, 64, 16, 4);
+
+    auto extract = [](const uint8_t* p, __m128i shuf, __m128i mul) {
+        const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        return _mm_srli_epi16(_mm_mullo_epi16(_mm_shuffle_epi8(s, shuf), mul), 6);
+    };
+
+    int x = 0;
+    for (; x + 12 <= W; x += 12) {
+        const uint8_t* s = src + (x / 6) * 16;
+        uint16_t* d = dst + x * 2;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d), extract(s, shuf0, mul0));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 8), extract(s + 8, shuf1, mul1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 16), extract(s + 16, shuf2, mul2));
+    }
+
+    if (x < W) {
+        Unpack_YUV422_10_Row_Scalar(src + (x / 6) * 16, dst + x * 2, W - x);
+    }
+}
+
+// 8 pixels (16 components, 20 bytes) per iteration as two 16-byte loads 10 bytes
+// apart; each load decodes 8 components from its first 10 bytes.
+void Unpack_YUV422_10_BigEnd_Row_SSSE3(const uint8_t* src, uint16_t* dst, int W)
+{
+    // Component j occupies bits 10j.. of the stream: byte 10j/8, bit offset
+    // 10j%8 from the MSB. Bytes are swapped into little-endian lanes.
+    const __m128i shuf = _mm_setr_epi8(1, 0, 2, 1, 3, 2, 4, 3, 6, 5, 7, 6, 8, 7, 9, 8);
+    const __m128i mul = _mm_setr_epi16(1, 4, 16, 64, 1, 4, 16, 64);
+
+    auto extract = [&](const uint8_t* p) {
+        const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        return _mm_srli_epi16(_mm_mullo_epi16(_mm_shuffle_epi8(s, shuf), mul), 6);
+    };
+
+    // The second load reads up to byte 26 of the 20-byte step, so stop while at
+    // least 12 pixels (30 bytes) remain.
+    int x = 0;
+    for (; x + 12 <= W; x += 8) {
+        const uint8_t* s = src + (x / 4) * 10;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 2), extract(s));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 2 + 8), extract(s + 10));
+    }
+
+    if (x < W) {
+        Unpack_YUV422_10_BigEnd_Row_Scalar(src + (x / 4) * 10, dst + x * 2, W - x);
+    }
+}
+
+// Limited-range expansion of 16 components: kRgbLimitedScale is 256 plus its
+// low part, so (c * scale + 128) >> 8 == c + ((c * low + 128) >> 8) in 16-bit
+// lanes. Alpha (255) saturates back to 255.
+template <bool LimitedRange>
+static inline __m128i ExpandRgbRange(__m128i v)
+{
+    if (!LimitedRange) return v;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i low = _mm_set1_epi16(int16_t(LowPart(kRgbLimitedScale)));
+    const __m128i rounding = _mm_set1_epi16(128);
+    const __m128i c = _mm_subs_epu8(v, _mm_set1_epi8(16));
+    auto expand = [&](__m128i w) {
+        return _mm_add_epi16(w, _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(w, low), rounding), 8));
+    };
+    return _mm_packus_epi16(expand(_mm_unpacklo_epi8(c, zero)), expand(_mm_unpackhi_epi8(c, zero)));
+}
+
+// 16 pixels (48 bytes, three loads) per iteration; PALIGNR lines up the four
+// 12-byte groups and one PSHUFB per group reorders R G B to B G R A.
+template <bool LimitedRange>
+void RGB24_to_BGRA_Row_SSSE3(const uint8_t* src, uint8_t* dst, int W)
+{
+    const __m128i shuf = _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+    const __m128i alpha = _mm_set1_epi32(int(0xFF000000u));
+    auto store = [&](uint8_t* d, __m128i group) {
+        const __m128i bgra = _mm_or_si128(_mm_shuffle_epi8(group, shuf), alpha);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d), ExpandRgbRange<LimitedRange>(bgra));
+    };
+
+    int x = 0;
+    for (; x + 16 <= W; x += 16) {
+        const uint8_t* s = src + x * 3;
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 16));
+        const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 32));
+        uint8_t* d = dst + x * 4;
+        store(d, a);
+        store(d + 16, _mm_alignr_epi8(b, a, 12));
+        store(d + 32, _mm_alignr_epi8(c, b, 8));
+        store(d + 48, _mm_srli_si128(c, 4));
+    }
+
+    if (x < W) {
+        RGB24_to_BGRA_Row_Scalar<LimitedRange>(src + x * 3, dst + x * 4, W - x);
+    }
+}
+
+template <bool LimitedRange>
+void RGB32_to_BGRA_Row_SSSE3(const uint8_t* src, uint8_t* dst, int W)
+{
+    const __m128i shuf = _mm_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const __m128i alpha = _mm_set1_epi32(int(0xFF000000u));
+
+    int x = 0;
+    for (; x + 4 <= W; x += 4) {
+        const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x * 4));
+        const __m128i bgra = _mm_or_si128(_mm_shuffle_epi8(s, shuf), alpha);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 4), ExpandRgbRange<LimitedRange>(bgra));
+    }
+
+    if (x < W) {
+        RGB32_to_BGRA_Row_Scalar<LimitedRange>(src + x * 4, dst + x * 4, W - x);
+    }
+}
+
+template void UYVY_to_BGRA_Row_SSSE3<ColorMatrix::Bt601Limited>(const uint8_t*, uint8_t*, int);
+template void UYVY_to_BGRA_Row_SSSE3<ColorMatrix::Bt601Full>(const uint8_t*, uint8_t*, int);
+template void UYVY_to_BGRA_Row_SSSE3<ColorMatrix::Bt709Limited>(const uint8_t*, uint8_t*, int);
+template void UYVY_to_BGRA_Row_SSSE3<ColorMatrix::Bt709Full>(const uint8_t*, uint8_t*, int);
+template void UYVY_to_BGRA_Row_SSSE3<ColorMatrix::Bt2020Limited>(const uint8_t*, uint8_t*, int);
+template void UYVY_to_BGRA_Row_SSSE3<ColorMatrix::Bt2020Full>(const uint8_t*, uint8_t*, int);
+
+template void RGB24_to_BGRA_Row_SSSE3<false>(const uint8_t*, uint8_t*, int);
+template void RGB24_to_BGRA_Row_SSSE3<true>(const uint8_t*, uint8_t*, int);
+template void RGB32_to_BGRA_Row_SSSE3<false>(const uint8_t*, uint8_t*, int);
+template void RGB32_to_BGRA_Row_SSSE3<true>(const uint8_t*, uint8_t*, int);
+
+#endif
@@ -0,0 +1,285 @@
+#include "record_pipe.hpp"
+#include "log_ring.hpp"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#  include <windows.h>
+#  include <mmsystem.h>      // timeBeginPeriod / timeEndPeriod
+#  pragma comment(lib, "winmm.lib")
+#else
+#  include <cerrno>
+#  include <csignal>
+#  include <ctime>
+#  include <fcntl.h>
+#  include <spawn.h>
+#  include <sys/uio.h>
+#  include <sys/wait.h>
+#  include <unistd.h>
+extern char** environ;
+#endif
+
+#ifdef _WIN32
+
+bool RecordPipe::Open(const std::string& commandLine, const std::string& logPath, size_t bytes,
+                      size_t /*maxFramesInPipe*/)
+{
+    Close();
+    frameBytes = bytes;
+
+    SECURITY_ATTRIBUTES sa{};
+    sa.nLength = sizeof(sa);
+    sa.bInheritHandle = TRUE;
+    sa.lpSecurityDescriptor = nullptr;
+
+    HANDLE hStdInRd = nullptr;
+    HANDLE hStdInWr = nullptr;
+    if (!CreatePipe(&hStdInRd, &hStdInWr, &sa, 0)) {
+        DC_LOG("rec: CreatePipe failed err={}", GetLastError());
+        return false;
+    }
+    // The write end stays in the parent and must NOT be inherited by the child.
+    SetHandleInformation(hStdInWr, HANDLE_FLAG_INHERIT, 0);
+
+    // The child's diagnostics go to a log file (a file, not a pipe, so it can
+    // never deadlock on a full pipe). Fall back to NUL if the log can't be created.
+    HANDLE hLog = INVALID_HANDLE_VALUE;
+    if (!logPath.empty()) {
+        hLog = CreateFileA(logPath.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                           &sa, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    }
+    if (hLog == INVALID_HANDLE_VALUE) {
+        hLog = CreateFileA("NUL", GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                           &sa, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    }
+
+    STARTUPINFOA si{};
+    si.cb = sizeof(si);
+    si.dwFlags = STARTF_USESTDHANDLES;
+    si.hStdInput = hStdInRd;
+    si.hStdOutput = hLog;
+    si.hStdError = hLog;
+
+    // CreateProcessA needs a writable command-line buffer.
+    std::vector<char> cmdline(commandLine.begin(), commandLine.end());
+    cmdline.push_back('\0');
+
+    PROCESS_INFORMATION pi;
+    ZeroMemory(&pi, sizeof(pi));
+    BOOL ok = CreateProcessA(
+        nullptr,            // lpApplicationName null -> search PATH using cmdline's first token
+        cmdline.data(),
+        nullptr, nullptr,
+        TRUE,               // inherit handles (pipe read end + log file)
+        CREATE_NO_WINDOW,
+        nullptr, nullptr,
+        &si, &pi);
+
+    // Parent's copies of the handles handed to the child.
+    CloseHandle(hStdInRd);
+    if (hLog != INVALID_HANDLE_VALUE) CloseHandle(hLog);
+
+    if (!ok) {
+        DC_LOG("rec: CreateProcess failed err={}", GetLastError());
+        CloseHandle(hStdInWr);
+        return false;
+    }
+    if (pi.hThread) CloseHandle(pi.hThread);
+    stdinWrite = hStdInWr;
+    process = pi.hProcess;
+    framesInPipe = 0;       // WriteFile copies
+    return true;
+}
+
+bool RecordPipe::Write(const uint8_t* data)
+{
+    // Write the whole frame, tolerating partial writes.
+    size_t off = 0;
+    while (off < frameBytes) {
+        DWORD chunk = (DWORD)std::min<size_t>(frameBytes - off, (size_t)(1u << 20));
+        DWORD written = 0;
+        if (!WriteFile(stdinWrite, data + off, chunk, &written, nullptr) || written == 0) {
+            return false;
+        }
+        off += written;
+    }
+    return true;
+}
+
+void RecordPipe::Close()
+{
+    if (stdinWrite) { CloseHandle(stdinWrite); stdinWrite = nullptr; }
+    if (process) {
+        WaitForSingleObject(process, INFINITE);
+        CloseHandle(process);
+        process = nullptr;
+    }
+}
+
+FramePacer::FramePacer() { timeBeginPeriod(1); }
+
+FramePacer::~FramePacer() { timeEndPeriod(1); }
+
+void FramePacer::SleepUntil(std::chrono::steady_clock::time_point deadline)
+{
+    std::this_thread::sleep_until(deadline);
+}
+
+#else // POSIX
+
+namespace {
+
+// Sizes the pipe to at most one frame (a power of two, at least the 64 KiB
+// default), so a large frame has left it once the next one is written.
+// Unprivileged processes are capped at /proc/sys/fs/pipe-max-size (1 MiB by
+// default). Returns the resulting size.
+size_t SizePipe(int fd, size_t frameBytes)
+{
+#ifdef F_SETPIPE_SZ
+    size_t wanted = size_t(64) << 10;
+    while (wanted * 2 <= std::min<size_t>(frameBytes, size_t(1) << 30)) wanted *= 2;
+    for (; wanted > (size_t(64) << 10); wanted /= 2) {
+        if (fcntl(fd, F_SETPIPE_SZ, int(wanted)) >= 0) break;
+    }
+    const int size = fcntl(fd, F_GETPIPE_SZ);
+    if (size > 0) return size_t(size);
+#else
+    (void)fd;
+    (void)frameBytes;
+#endif
+    return size_t(64) << 10;
+}
+
+} // namespace
+
+bool RecordPipe::Open(const std::string& commandLine, const std::string& logPath, size_t bytes,
+                      size_t maxFramesInPipe)
+{
+    Close();
+    frameBytes = bytes;
+
+    // A child that exits early must fail the write, not raise SIGPIPE in the host.
+    sigset_t pipeSignal;
+    sigemptyset(&pipeSignal);
+    sigaddset(&pipeSignal, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &pipeSignal, nullptr);
+
+    // Both ends close-on-exec: other children (another stream's recorder) must
+    // not keep a copy of the write end, or this child never sees end of file.
+    int fds[2];
+    if (pipe(fds) != 0) {
+        DC_LOG("rec: pipe failed errno={}", errno);
+        return false;
+    }
+    fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+    const size_t pipeBytes = SizePipe(fds[1], frameBytes);
+
+    int log = logPath.empty() ? -1 : open(logPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (log < 0) log = open("/dev/null", O_WRONLY | O_CLOEXEC);
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, fds[0], 0);
+    if (log >= 0) {
+        posix_spawn_file_actions_adddup2(&actions, log, 1);
+        posix_spawn_file_actions_adddup2(&actions, log, 2);
+    }
+
+    // The child starts with the default signal mask, not the writer's.
+    posix_spawnattr_t attr;
+    posix_spawnattr_init(&attr);
+    sigset_t none;
+    sigemptyset(&none);
+    posix_spawnattr_setsigmask(&attr, &none);
+    posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSIGMASK);
+
+    const char* argv[] = { "/bin/sh", "-c", commandLine.c_str(), nullptr };
+    pid_t child = -1;
+    const int err = posix_spawn(&child, "/bin/sh", &actions, &attr, const_cast<char* const*>(argv), environ);
+
+    posix_spawnattr_destroy(&attr);
+    posix_spawn_file_actions_destroy(&actions);
+    close(fds[0]);
+    if (log >= 0) close(log);
+
+    if (err != 0) {
+        DC_LOG("rec: posix_spawn failed err={}", err);
+        close(fds[1]);
+        return false;
+    }
+    stdinWrite = fds[1];
+    pid = int(child);
+
+    // Spliced pages stay referenced until the child reads them, that is until a
+    // pipe's worth of later frames was written. Kept after a fallback to write():
+    // earlier frames may still be in the pipe.
+    framesInPipe = 0;
+    zeroCopy = false;
+#ifdef __linux__
+    const size_t spliced = (pipeBytes + frameBytes - 1) / frameBytes;
+    if (spliced <= maxFramesInPipe) {
+        zeroCopy = true;
+        framesInPipe = spliced;
+    }
+#else
+    (void)maxFramesInPipe;
+#endif
+    DC_LOG("rec: pipe {} KiB, {}", pipeBytes >> 10, zeroCopy ? "vmsplice" : "write");
+    return true;
+}
+
+bool RecordPipe::Write(const uint8_t* data)
+{
+    size_t off = 0;
+    while (off < frameBytes) {
+        ssize_t n;
+#ifdef __linux__
+        if (zeroCopy) {
+            iovec iov{ const_cast<uint8_t*>(data + off), frameBytes - off };
+            n = vmsplice(stdinWrite, &iov, 1, 0);
+            if (n < 0 && (errno == EINVAL || errno == ENOSYS)) {
+                // Not a pipe vmsplice accepts (e.g. a restricted kernel): copy from now on.
+                DC_LOG("rec: vmsplice unavailable errno={}, falling back to write", errno);
+                zeroCopy = false;
+                continue;
+            }
+        }
+        else
+#endif
+        {
+            n = write(stdinWrite, data + off, frameBytes - off);
+        }
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        off += size_t(n);
+    }
+    return true;
+}
+
+void RecordPipe::Close()
+{
+    if (stdinWrite >= 0) { close(stdinWrite); stdinWrite = -1; }
+    if (pid > 0) {
+        int status = 0;
+        while (waitpid(pid_t(pid), &status, 0) < 0 && errno == EINTR) {}
+        pid = -1;
+    }
+}
+
+FramePacer::FramePacer() {}
+
+FramePacer::~FramePacer() {}
+
+void FramePacer::SleepUntil(std::chrono::steady_clock::time_point deadline)
+{
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+    timespec ts;
+    ts.tv_sec = time_t(ns / 1000000000);
+    ts.tv_nsec = long(ns % 1000000000);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {}
+}
+
+#endif
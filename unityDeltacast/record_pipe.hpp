@@ -0,0 +1,73 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// The recorder's child process (ffmpeg, or any stand-in that reads raw frames
+// from stdin, e.g. `cat > frames.raw`) and the pipe feeding it.
+//
+// Windows starts the command line with CreateProcess and writes with WriteFile.
+// POSIX starts it with posix_spawn through /bin/sh -c, sizes the pipe
+// (F_SETPIPE_SZ) to at most one frame, and on Linux hands the frame pages to the
+// pipe with vmsplice instead of copying them through write(). The pipe then
+// references the caller's memory until the child reads it: a written frame must
+// stay unmodified until FramesInPipe() more frames were written after it.
+class RecordPipe {
+public:
+    RecordPipe() = default;
+    ~RecordPipe() { Close(); }
+    RecordPipe(const RecordPipe&) = delete;
+    RecordPipe& operator=(const RecordPipe&) = delete;
+
+    // Starts `commandLine` with stdin = the pipe and stdout/stderr = `logPath`
+    // (the null device if empty or if it cannot be created). Frames written
+    // later are `frameBytes` long. On POSIX, the calling thread blocks SIGPIPE
+    // from then on, so a child that exits early fails Write() instead of killing
+    // the process. If zero copy would need FramesInPipe() above
+    // `maxFramesInPipe` (frames smaller than the pipe), writes copy instead.
+    bool Open(const std::string& commandLine, const std::string& logPath, size_t frameBytes,
+              size_t maxFramesInPipe);
+
+    // Writes one frame (frameBytes from `frame`). False once the child stopped
+    // reading.
+    bool Write(const uint8_t* frame);
+
+    // How many later frames must be written before the memory of a written frame
+    // is no longer referenced by the pipe; 0 when writes copy.
+    size_t FramesInPipe() const { return framesInPipe; }
+
+    // Closes the child's stdin (ffmpeg finalizes its output) and waits for it to exit.
+    void Close();
+
+    // vmsplice is in use (Linux) rather than a copying write.
+    bool ZeroCopy() const { return zeroCopy; }
+
+private:
+    size_t frameBytes = 0;
+    size_t framesInPipe = 0;
+    bool zeroCopy = false;
+
+#ifdef _WIN32
+    void* stdinWrite = nullptr;     // HANDLE
+    void* process = nullptr;        // HANDLE
+#else
+    int stdinWrite = -1;
+    int pid = -1;
+#endif
+};
+
+// Sleeps the recorder's writer until absolute steady_clock deadlines: raises the
+// Windows timer resolution to 1 ms for its lifetime, and uses
+// clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME) on POSIX, which is the clock
+// steady_clock reads there.
+class FramePacer {
+public:
+    FramePacer();
+    ~FramePacer();
+    FramePacer(const FramePacer&) = delete;
+    FramePacer& operator=(const FramePacer&) = delete;
+
+    void SleepUntil(std::chrono::steady_clock::time_point deadline);
+};
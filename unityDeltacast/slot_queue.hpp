@@ -0,0 +1,151 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// Bounded hand-off queue between a stream's slot drain thread (producer) and
+// its conversion thread (consumer).
+//
+// One producer, one consumer, but the producer may also discard the oldest
+// entry itself when the queue is full (DropOldest). Claiming an entry is
+// therefore a CAS on `head` followed by emptying its cell, and the producer
+// only refills a cell once its previous claimer has emptied it, so a late
+// claimer can never take a newer item. Push and pop never lock: the mutex and
+// condition variable only park a side that has nothing to do, and the other
+// side touches them only while someone is parked.
+template <class T>
+class SlotQueue {
+public:
+    enum class Policy {
+        DropOldest,     // full: release the oldest queued item, keep the new one
+        Block,          // full: wait for the consumer
+    };
+
+    explicit SlotQueue(int capacity = 2) { Reset(capacity); }
+    ~SlotQueue() { Clear(); }
+
+    SlotQueue(const SlotQueue&) = delete;
+    SlotQueue& operator=(const SlotQueue&) = delete;
+
+    // Drops queued items and resizes. Only call while neither side is running.
+    void Reset(int capacity)
+    {
+        Clear();
+        if (capacity < 1) capacity = 1;
+        cells.reset(new std::atomic<T*>[size_t(capacity)]());
+        size = uint64_t(capacity);
+        head.store(0, std::memory_order_relaxed);
+        tail.store(0, std::memory_order_relaxed);
+        drops.store(0, std::memory_order_relaxed);
+    }
+
+    // ---- producer ----
+
+    // Queues `item`. Returns false only if Block had to wait and `running`
+    // went false meanwhile; the item is then released.
+    bool Push(std::unique_ptr<T> item, Policy policy, const std::atomic<bool>& running)
+    {
+        for (;;) {
+            const uint64_t t = tail.load(std::memory_order_relaxed);
+            if (t - head.load(std::memory_order_seq_cst) < size) {
+                std::atomic<T*>& cell = cells[t % size];
+                if (cell.load(std::memory_order_acquire) != nullptr) {
+                    // Claimed by the consumer but not emptied yet.
+                    std::this_thread::yield();
+                    continue;
+                }
+                cell.store(item.release(), std::memory_order_relaxed);
+                tail.store(t + 1, std::memory_order_seq_cst);
+                Wake();
+                return true;
+            }
+
+            if (policy == Policy::DropOldest) {
+                if (TryPop()) drops.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+
+            if (!running.load(std::memory_order_relaxed)) return false;
+            Park([&] { return tail.load(std::memory_order_relaxed) - head.load(std::memory_order_seq_cst) < size; });
+        }
+    }
+
+    // Releases every queued item.
+    void Clear()
+    {
+        if (!cells) return;
+        while (TryPop()) {}
+    }
+
+    // ---- consumer ----
+
+    std::unique_ptr<T> TryPop()
+    {
+        uint64_t h = head.load(std::memory_order_seq_cst);
+        for (;;) {
+            if (h == tail.load(std::memory_order_seq_cst)) return nullptr;
+            if (head.compare_exchange_weak(h, h + 1, std::memory_order_seq_cst)) {
+                T* p = cells[h % size].exchange(nullptr, std::memory_order_acq_rel);
+                Wake();
+                return std::unique_ptr<T>(p);
+            }
+        }
+    }
+
+    // TryPop(), parking up to `timeout` while the queue is empty.
+    std::unique_ptr<T> WaitPop(std::chrono::milliseconds timeout)
+    {
+        if (auto item = TryPop()) return item;
+        Park([&] { return tail.load(std::memory_order_seq_cst) != head.load(std::memory_order_seq_cst); }, timeout);
+        return TryPop();
+    }
+
+    // Wakes a parked side so it re-checks its exit condition.
+    void Wake()
+    {
+        if (parked.load(std::memory_order_seq_cst) == 0) return;
+        { std::lock_guard<std::mutex> lk(parkMutex); }
+        parkCv.notify_all();
+    }
+
+    // ---- counters (any thread) ----
+
+    int Occupancy() const
+    {
+        const uint64_t t = tail.load(std::memory_order_relaxed);
+        const uint64_t h = head.load(std::memory_order_relaxed);
+        return t > h ? int(t - h) : 0;
+    }
+
+    int Capacity() const { return int(size); }
+
+    // Items released unconverted by DropOldest since the last Reset().
+    unsigned long long Drops() const { return drops.load(std::memory_order_relaxed); }
+
+private:
+    template <class Pred>
+    void Park(Pred ready, std::chrono::milliseconds timeout = std::chrono::milliseconds(10))
+    {
+        parked.fetch_add(1, std::memory_order_seq_cst);
+        {
+            std::unique_lock<std::mutex> lk(parkMutex);
+            parkCv.wait_for(lk, timeout, ready);
+        }
+        parked.fetch_sub(1, std::memory_order_seq_cst);
+    }
+
+    std::unique_ptr<std::atomic<T*>[]> cells;
+    uint64_t size = 0;
+    std::atomic<uint64_t> head{ 0 };
+    std::atomic<uint64_t> tail{ 0 };
+    std::atomic<unsigned long long> drops{ 0 };
+
+    std::atomic<int> parked{ 0 };
+    std::mutex parkMutex;
+    std::condition_variable parkCv;
+};
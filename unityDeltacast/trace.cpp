@@ -0,0 +1,147 @@
+#include "trace.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+
+std::atomic<bool> Tracer::enabled{ false };
+
+namespace {
+
+// The calling thread's trace name and ring. The ring is released for reuse
+// when the thread exits.
+struct ThreadTrace {
+    std::string name;
+    void* buffer = nullptr;
+    std::atomic<bool>* owned = nullptr;
+
+    ~ThreadTrace()
+    {
+        if (owned) owned->store(false, std::memory_order_release);
+    }
+};
+
+thread_local ThreadTrace threadTrace;
+
+// JSON string contents: thread names may come from the caller.
+std::string Escape(const std::string& s)
+{
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        if (static_cast<unsigned char>(c) < 0x20) continue;
+        out += c;
+    }
+    return out;
+}
+
+} // namespace
+
+Tracer& Tracer::Instance()
+{
+    static Tracer tracer;
+    return tracer;
+}
+
+void Tracer::SetEnabled(bool on)
+{
+    if (on) startNs.store(Now(), std::memory_order_relaxed);
+    enabled.store(on, std::memory_order_relaxed);
+}
+
+void Tracer::NameThread(const std::string& name)
+{
+    threadTrace.name = name;
+    if (threadTrace.buffer) {
+        Tracer& tracer = Instance();
+        std::lock_guard<std::mutex> lk(tracer.registryMutex);
+        static_cast<ThreadBuffer*>(threadTrace.buffer)->threadName = name;
+    }
+}
+
+Tracer::ThreadBuffer* Tracer::Acquire()
+{
+    std::lock_guard<std::mutex> lk(registryMutex);
+    ThreadBuffer* b = nullptr;
+    for (auto& candidate : buffers) {
+        bool owned = false;
+        if (candidate->owned.compare_exchange_strong(owned, true, std::memory_order_acquire)) {
+            b = candidate.get();
+            break;
+        }
+    }
+    if (!b) {
+        buffers.push_back(std::make_unique<ThreadBuffer>());
+        b = buffers.back().get();
+        b->tid = int(buffers.size());
+        b->events.reset(new Event[kEventsPerThread]);
+        b->owned.store(true, std::memory_order_relaxed);
+    }
+    b->threadName = threadTrace.name.empty() ? "thread " + std::to_string(b->tid) : threadTrace.name;
+    b->head.store(0, std::memory_order_release);
+    threadTrace.buffer = b;
+    threadTrace.owned = &b->owned;
+    return b;
+}
+
+void Tracer::Record(const char* name, int64_t beginNs, int64_t endNs, unsigned long long frame)
+{
+    ThreadBuffer* b = static_cast<ThreadBuffer*>(threadTrace.buffer);
+    if (!b) b = Acquire();
+
+    const unsigned long long i = b->head.load(std::memory_order_relaxed);
+    Event& e = b->events[i % kEventsPerThread];
+    e.name.store(name, std::memory_order_relaxed);
+    e.beginNs.store(beginNs, std::memory_order_relaxed);
+    e.endNs.store(endNs, std::memory_order_relaxed);
+    e.frame.store(frame, std::memory_order_relaxed);
+    b->head.store(i + 1, std::memory_order_release);
+}
+
+int Tracer::Dump(const std::string& path)
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) return -1;
+
+    struct Copy {
+        const char* name;
+        int64_t beginNs, endNs;
+        unsigned long long frame;
+    };
+    const int64_t origin = startNs.load(std::memory_order_relaxed);
+    int written = 0;
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    out << std::fixed << std::setprecision(3);
+
+    std::lock_guard<std::mutex> lk(registryMutex);
+    std::vector<Copy> events;
+    for (const auto& b : buffers) {
+        const unsigned long long head = b->head.load(std::memory_order_acquire);
+        const unsigned long long first = head > kEventsPerThread ? head - kEventsPerThread : 0;
+        events.clear();
+        for (unsigned long long i = first; i < head; ++i) {
+            const Event& e = b->events[i % kEventsPerThread];
+            events.push_back({ e.name.load(std::memory_order_relaxed), e.beginNs.load(std::memory_order_relaxed),
+                               e.endNs.load(std::memory_order_relaxed), e.frame.load(std::memory_order_relaxed) });
+        }
+        // Slots the thread reused meanwhile (including the one it may be writing) are stale.
+        const unsigned long long after = b->head.load(std::memory_order_acquire);
+        const unsigned long long valid = after >= kEventsPerThread ? after - kEventsPerThread + 1 : 0;
+
+        out << (written ? ",\n" : "") << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << b->tid
+            << ",\"args\":{\"name\":\"" << Escape(b->threadName) << "\"}}";
+        ++written;
+        for (unsigned long long i = std::max(first, valid); i < head; ++i) {
+            const Copy& e = events[size_t(i - first)];
+            if (!e.name || e.beginNs < origin) continue;
+            out << ",\n{\"ph\":\"X\",\"name\":\"" << e.name << "\",\"pid\":1,\"tid\":" << b->tid
+                << ",\"ts\":" << double(e.beginNs - origin) / 1e3
+                << ",\"dur\":" << double(e.endNs - e.beginNs) / 1e3
+                << ",\"args\":{\"frame\":" << e.frame << "}}";
+            ++written;
+        }
+    }
+    out << "\n]}\n";
+    return out ? written - int(buffers.size()) : -1;
+}
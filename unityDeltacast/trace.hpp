@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Opt-in timeline of the pipeline stages, written as a Chrome trace
+// (chrome://tracing, ui.perfetto.dev).
+//
+// A stage is a TraceScope: one complete event (begin, end, frame number) on the
+// calling thread. Each thread records into its own preallocated ring of
+// kEventsPerThread events, allocated the first time it records, so recording is
+// a few relaxed stores and one release store, with no lock and no allocation.
+// The rings keep the most recent events (a flight recorder), so a stutter can
+// be dumped after the fact. While tracing is off a scope costs one relaxed load.
+//
+// Dump() may run while threads record: it copies each ring and discards the
+// events that were overwritten during the copy. A ring is handed to a new
+// thread once its thread has exited, so the events of exited threads survive
+// until their ring is reused.
+class Tracer {
+public:
+    static constexpr int kEventsPerThread = 1 << 14;
+
+    static Tracer& Instance();
+
+    static bool Enabled() { return enabled.load(std::memory_order_relaxed); }
+
+    static int64_t Now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Turning tracing on starts a new trace: earlier events are not dumped.
+    void SetEnabled(bool on);
+
+    // Names the calling thread in the trace (taken when it first records).
+    static void NameThread(const std::string& name);
+
+    void Record(const char* name, int64_t beginNs, int64_t endNs, unsigned long long frame);
+
+    // Writes the events of the current trace to `path` as Chrome trace JSON.
+    // Returns the number of events written, or -1 if the file cannot be written.
+    int Dump(const std::string& path);
+
+private:
+    struct Event {
+        std::atomic<const char*> name{ nullptr };     // static string
+        std::atomic<int64_t> beginNs{ 0 };
+        std::atomic<int64_t> endNs{ 0 };
+        std::atomic<unsigned long long> frame{ 0 };
+    };
+
+    struct ThreadBuffer {
+        int tid = 0;
+        std::string threadName;
+        std::unique_ptr<Event[]> events;
+        std::atomic<unsigned long long> head{ 0 };    // events ever recorded
+        std::atomic<bool> owned{ false };             // a live thread records into it
+    };
+
+    ThreadBuffer* Acquire();
+
+    static std::atomic<bool> enabled;
+    std::atomic<int64_t> startNs{ 0 };
+    std::mutex registryMutex;                         // guards buffers (registration, dump)
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+};
+
+// Records the enclosing block as one event named `name` (a string literal).
+class TraceScope {
+public:
+    explicit TraceScope(const char* name, unsigned long long frame = 0)
+        : name(Tracer::Enabled() ? name : nullptr), frame(frame)
+    {
+        if (this->name) beginNs = Tracer::Now();
+    }
+
+    ~TraceScope() { End(); }
+
+    // Ends the event before the enclosing block does.
+    void End()
+    {
+        if (name) Tracer::Instance().Record(name, beginNs, Tracer::Now(), frame);
+        name = nullptr;
+    }
+
+    // The frame number, once the stage knows it.
+    void SetFrame(unsigned long long f) { frame = f; }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* name;
+    unsigned long long frame;
+    int64_t beginNs = 0;
+};
@@ -5,11 +5,13 @@
 #include <thread>
 #include <variant>
 #include <mutex>
+#include <condition_variable>
 #include <vector>
 #include <algorithm>
 #include <chrono>
 #include <sstream>
 #include <array>
+#include <deque>
 #include <cstring>
 
 // NOMINMAX must be set before any windows.h inclusion so the min/max macros don't clobber
@@ -27,26 +29,17 @@
 #include <VideoMasterCppApi/helper/sdi.hpp>
 
 #include "../src/helper.hpp"
-
-// Windows process/pipe API for the offloaded ffmpeg recording. Included AFTER the VideoMaster
-// headers on purpose: windows.h #defines `interface` (-> struct) and `GetMessage`, which would
-// otherwise break VideoMaster's headers and collide with our exported GetMessage(). Undef
-// GetMessage right after the include so our exported symbol keeps its name.
-#include <windows.h>
-#include <mmsystem.h>      // timeBeginPeriod / timeEndPeriod
-#pragma comment(lib, "winmm.lib")
-#ifdef GetMessage
-#undef GetMessage
-#endif
-
-// Statement-like macro with file, line, and function
-#define DC_LOG(MSG)                                                        \
-    do {                                                                   \
-        logHelper( std::string("[") + __FILE__ + ":" +                     \
-                   std::to_string(__LINE__) + " " + __func__ + "] " +      \
-                   std::string(MSG) );                                     \
-    } while (0)
-
+#include "pixel_convert.hpp"
+#include "conversion_pool.hpp"
+#include "deinterlace.hpp"
+#include "mosaic.hpp"
+#include "frame_ring.hpp"
+#include "frame_timing.hpp"
+#include "slot_queue.hpp"
+#include "signal_monitor.hpp"
+#include "log_ring.hpp"
+#include "trace.hpp"
+#include "record_pipe.hpp"
 
 using namespace Application::Helper;
 
@@ -67,17 +60,17 @@ using namespace Deltacast::Wrapper;
 static std::atomic<bool> running[4] = { false, false, false, false };
 static std::thread captureThread[4];
 
-static std::vector<uint8_t> latestFrame[4];
-static std::mutex frameMutex[4];
+// Published frames per stream; see frame_ring.hpp. Readers never block the capture thread.
+static FrameRing frameRings[4];
+// Stage timestamps of the frames published to frameRings[] by StartCapture; see frame_timing.hpp.
+static FrameTimingLog frameTimings[4];
 
 
 
 //static std::vector<uint8_t> bgra;  // scratch BGRA frame
 //static std::vector<uint8_t> bgra2;  // scratch BGRA frame
 
-static std::vector<uint8_t> bgra[4];
-
-// simple static message buffer
+// GetMessage's text, built from the log records (log_ring.hpp) when it drains them
 static std::string message = "Hello Deltacast DLL!\n";
 static std::mutex  messageMutex;
 
@@ -127,13 +120,14 @@ static void SetVideoInfo(int index, std::string text) {
 
 // A 1080i50 Level-B dual-stream signal contains 50 temporally distinct fields
 // per second, but only 25 complete interlaced frames. A fieldMerge value of 0
-// selects field mode for this specific signal type so each field can be
-// published as its own bob-deinterlaced, full-height frame. Other signal types
-// retain the old fieldMerge == 0 behavior.
-static bool ShouldUseFieldModeBob(const SignalInformation& signalInformation,
-                                  unsigned int fieldMerge)
+// (or 2) selects field mode for this specific signal type so each field can be
+// published as its own bob- (or motion-adaptively) deinterlaced, full-height
+// frame. Other signal types retain the old fieldMerge == 0 behavior.
+static bool ShouldUseFieldMode(const SignalInformation& signalInformation,
+                               unsigned int fieldMerge)
 {
-    if (fieldMerge != UNITYDELTACAST_FIELD_MODE_BOB) return false;
+    if (fieldMerge != UNITYDELTACAST_FIELD_MODE_BOB
+        && fieldMerge != UNITYDELTACAST_FIELD_MODE_MOTION_ADAPTIVE) return false;
 
     const auto* sdi = std::get_if<SdiSignalInformation>(&signalInformation);
     if (!sdi
@@ -144,125 +138,259 @@ static bool ShouldUseFieldModeBob(const SignalInformation& signalInformation,
 }
 
 
-inline uint8_t clamp8(int x) {
-    return (uint8_t)(x < 0 ? 0 : x>255 ? 255 : x);
+// Banded Convert422 on the conversion pool. The kernel for the frame's packing and
+// format is resolved once; the dither phase of each output row does not depend
+// on the band split.
+static ConversionPool::Timing Convert422_Parallel(SourcePacking packing, OutputFormat format, ColorMatrix matrix,
+                                                  const uint8_t* src, int srcPitch,
+                                                  uint8_t* dst, int dstPitch,
+                                                  int W, int H, bool flipY)
+{
+    const Convert422RowsKernel rows = GetConvert422RowsKernel(packing, format, flipY, matrix);
+    return ConversionPool::Instance().ParallelBands(H, kMinRowsPerBand, [&](int y0, int y1) {
+        rows(src, srcPitch, dst, dstPitch, W, H, y0, y1);
+    });
 }
 
-// UYVY (U Y0 V Y1) -> BGRA, optional vertical flip
-static void UYVY_to_BGRA(const uint8_t* src, int srcPitch, uint8_t* dst, int dstPitch, int W, int H, bool flipY)
+// Banded RGB -> BGRA on the conversion pool, the row kernel resolved once.
+static ConversionPool::Timing ConvertRGB_Parallel(RgbPacking packing, bool limitedRange,
+                                                  const uint8_t* src, int srcPitch,
+                                                  uint8_t* dst, int dstPitch,
+                                                  int W, int H, bool flipY)
 {
-    for (int y = 0; y < H; ++y) {
-        const uint8_t* s = src + y * srcPitch;
-        // write to bottom-up row if flipping
-        uint8_t* d = dst + (flipY ? (H - 1 - y) * dstPitch : y * dstPitch);
-
-        for (int x = 0; x < W; x += 2) {
-            int U = int(s[0]) - 128;
-            int Y0 = int(s[1]);
-            int V = int(s[2]) - 128;
-            int Y1 = int(s[3]);
-            s += 4;
-
-            auto emit = [&](int Y) {
-                int C = Y - 16; if (C < 0) C = 0;
-                int R = clamp8((298 * C + 409 * V + 128) >> 8);
-                int G = clamp8((298 * C - 100 * U - 208 * V + 128) >> 8);
-                int B = clamp8((298 * C + 516 * U + 128) >> 8);
-                *d++ = (uint8_t)B;
-                *d++ = (uint8_t)G;
-                *d++ = (uint8_t)R;
-                *d++ = 255; // A
-                };
-
-            emit(Y0);
-            emit(Y1);
+    const RgbRowKernel row = GetRgbRowKernel(packing, limitedRange, SelectedConversionPath());
+    return ConversionPool::Instance().ParallelBands(H, kMinRowsPerBand, [&](int y0, int y1) {
+        for (int y = y0; y < y1; ++y) {
+            row(src + size_t(y) * srcPitch, dst + size_t(flipY ? H - 1 - y : y) * dstPitch, W);
         }
-    }
+    });
 }
 
-// Convert one packed UYVY field to a full-height BGRA frame using bob
-// deinterlacing. Field lines are copied to their natural parity and the missing
-// lines are interpolated from the nearest captured lines. The SDK returns field
-// lines contiguously; totalBytes may describe either the field payload or a
-// full-frame-sized slot allocation, so derive padding only for a half-frame
-// payload and otherwise use the natural UYVY row size.
-static bool UYVY_Field_to_BGRA_Bob(const uint8_t* src,
-                                   size_t totalBytes,
-                                   uint8_t* dst,
-                                   int dstPitch,
-                                   int W,
-                                   int H,
-                                   bool evenField,
-                                   bool flipY)
+// One eye of a stereo pair: a field-merged UYVY frame.
+struct StereoEye {
+    const uint8_t* src;
+    int srcPitch;
+    int width;
+    int height;
+};
+
+// Converts both eyes straight into their halves of the outW x outH BGRA
+// side-by-side frame (left at x = 0, right at x = left.width), bob-deinterlaced
+// and flipped, in one batch on the conversion pool: the bands run over the rows
+// of both eyes, so the eyes convert concurrently. Rows below an eye are cleared.
+static ConversionPool::Timing ConvertStereoSideBySide(const StereoEye (&eyes)[2], uint8_t* dst,
+                                                      int outW, int outH, bool topFieldFirst,
+                                                      ColorMatrix matrix)
 {
-    if (!src || !dst || W <= 0 || H <= 0 || (W & 1) != 0) return false;
+    const int outPitch = outW * 4;
+    return ConversionPool::Instance().ParallelBands(2 * outH, kMinRowsPerBand, [&](int b0, int b1) {
+        for (int e = 0; e < 2; ++e) {
+            const StereoEye& eye = eyes[e];
+            uint8_t* eyeDst = dst + (e == 0 ? 0 : size_t(eyes[0].width) * 4);
+            const int y0 = std::max(b0 - e * outH, 0);
+            const int y1 = std::min(b1 - e * outH, outH);
+            if (y0 >= y1) continue;
+
+            UYVY_to_BGRA_FrameBob_Rows(eye.src, eye.srcPitch, eyeDst, outPitch,
+                                       eye.width, eye.height, topFieldFirst, true, matrix,
+                                       y0, std::min(y1, eye.height));
+            for (int y = std::max(y0, eye.height); y < y1; ++y) {
+                std::memset(eyeDst + size_t(y) * outPitch, 0, size_t(eye.width) * 4);
+            }
+        }
+    });
+}
 
-    // Field 1/odd carries display rows 0,2,4...; field 2/even carries
-    // display rows 1,3,5... (zero-based row coordinates).
-    const int sourceParity = evenField ? 1 : 0;
-    const int fieldRows = (H - sourceParity + 1) / 2;
-    if (fieldRows <= 0) return false;
+// VHD_BUFFERPACKING -> the 4:2:2 layouts the converter reads. Other packings
+// fall back to 8-bit UYVY, which is how every packing used to be converted.
+static SourcePacking ToSourcePacking(VHD_BUFFERPACKING packing)
+{
+    switch (packing) {
+    case VHD_BUFPACK_VIDEO_YUV422_10:              return SourcePacking::YUV422_10;
+    case VHD_BUFPACK_VIDEO_YUV422_10_NOPAD_BIGEND: return SourcePacking::YUV422_10_BigEnd;
+    case VHD_BUFPACK_VIDEO_YUV422_16:              return SourcePacking::YUV422_16;
+    default:                                       return SourcePacking::UYVY8;
+    }
+}
 
-    const size_t rowBytes = size_t(W) * 2; // UYVY 4:2:2 8-bit
-    const size_t minimumFieldBytes = rowBytes * size_t(fieldRows);
-    if (totalBytes < minimumFieldBytes) return false;
+// How a capture reads the board's buffers. DV signals whose cable carries RGB
+// are captured as RGB 4:4:4 (RGB_24 unless an RGB packing was requested) and
+// only reordered to BGRA, instead of being subsampled to 4:2:2 by the board and
+// converted back with a YCbCr matrix. Everything else uses the requested packing.
+struct CaptureLayout {
+    VHD_BUFFERPACKING bufferPacking = VHD_BUFPACK_VIDEO_YUV422_8;
+    SourcePacking packing = SourcePacking::UYVY8;   // when !rgb
+    bool rgb = false;
+    RgbPacking rgbPacking = RgbPacking::RGB24;
+    bool rgbLimitedRange = false;                   // 16..235, expanded to 0..255
+};
 
-    size_t srcPitch = rowBytes;
-    const size_t minimumFrameBytes = rowBytes * size_t(H);
-    if (totalBytes < minimumFrameBytes && totalBytes % size_t(fieldRows) == 0) {
-        const size_t candidatePitch = totalBytes / size_t(fieldRows);
-        if (candidatePitch >= rowBytes) srcPitch = candidatePitch;
+static CaptureLayout SelectCaptureLayout(const SignalInformation& signalInformation, VHD_BUFFERPACKING requested)
+{
+    CaptureLayout layout;
+    layout.bufferPacking = requested;
+    layout.packing = ToSourcePacking(requested);
+
+    bool rgbSignal = false;
+    if (const auto* dv = std::get_if<DvSignalInformation>(&signalInformation)) {
+        switch (dv->cable_color_space) {
+        case VHD_DV_CS_RGB_LIMITED:
+        case VHD_DV_CS_BT2020_RGB_LIMITED:
+            layout.rgbLimitedRange = true;
+            rgbSignal = true;
+            break;
+        case VHD_DV_CS_RGB_FULL:
+        case VHD_DV_CS_ADOBE_RGB:
+        case VHD_DV_CS_BT2020_RGB_FULL:
+        case VHD_DV_CS_DCI_P3_RGB_D65:
+        case VHD_DV_CS_DCI_P3_RGB_THEATER:
+            rgbSignal = true;
+            break;
+        default:
+            break;
+        }
     }
 
-    if ((size_t(fieldRows - 1) * srcPitch) + rowBytes > totalBytes) return false;
+    if (requested == VHD_BUFPACK_VIDEO_RGB_24 || requested == VHD_BUFPACK_VIDEO_RGB_32) {
+        layout.rgb = true;
+        layout.rgbPacking = requested == VHD_BUFPACK_VIDEO_RGB_32 ? RgbPacking::RGB32 : RgbPacking::RGB24;
+    }
+    else if (rgbSignal) {
+        layout.rgb = true;
+        layout.bufferPacking = VHD_BUFPACK_VIDEO_RGB_24;
+    }
+    return layout;
+}
 
-    // Convert every real field line into its full-frame row.
-    for (int fieldY = 0; fieldY < fieldRows; ++fieldY) {
-        const int sourceFrameY = fieldY * 2 + sourceParity;
-        const int outputY = flipY ? (H - 1 - sourceFrameY) : sourceFrameY;
+// Per-stream published pixel format (SetOutputFormat), applied from the next frame on.
+static std::atomic<unsigned int> outputFormat[4] = {
+    UNITYDELTACAST_OUTPUT_BGRA8, UNITYDELTACAST_OUTPUT_BGRA8,
+    UNITYDELTACAST_OUTPUT_BGRA8, UNITYDELTACAST_OUTPUT_BGRA8
+};
 
-        UYVY_to_BGRA(
-            src + size_t(fieldY) * srcPitch,
-            int(srcPitch),
-            dst + size_t(outputY) * dstPitch,
-            dstPitch,
-            W,
-            1,
-            false);
+// Per-stream YCbCr -> RGB matrix (SetColorMatrix): UNITYDELTACAST_COLOR_MATRIX_AUTO
+// follows the signal, anything else overrides it. Applied from the next frame on.
+static std::atomic<unsigned int> colorMatrixSetting[4] = {
+    UNITYDELTACAST_COLOR_MATRIX_AUTO, UNITYDELTACAST_COLOR_MATRIX_AUTO,
+    UNITYDELTACAST_COLOR_MATRIX_AUTO, UNITYDELTACAST_COLOR_MATRIX_AUTO
+};
+// UNITYDELTACAST_COLOR_MATRIX_* the last published frame was converted with.
+static std::atomic<unsigned int> activeColorMatrix[4] = {
+    UNITYDELTACAST_COLOR_MATRIX_AUTO, UNITYDELTACAST_COLOR_MATRIX_AUTO,
+    UNITYDELTACAST_COLOR_MATRIX_AUTO, UNITYDELTACAST_COLOR_MATRIX_AUTO
+};
+
+// The matrix a signal's YCbCr is encoded with. DV signals carry their cable
+// colorimetry; SDI signal information has none, so SD standards are taken as
+// BT.601 and everything else as BT.709, both limited range (SMPTE 125M/274M).
+static ColorMatrix DetectColorMatrix(const SignalInformation& signalInformation)
+{
+    if (const auto* dv = std::get_if<DvSignalInformation>(&signalInformation)) {
+        switch (dv->cable_color_space) {
+        case VHD_DV_CS_YUV601:
+        case VHD_DV_CS_XVYCC_601:       return ColorMatrix::Bt601Limited;
+        case VHD_DV_CS_YUV_601_FULL:
+        case VHD_DV_CS_SYCC_601:
+        case VHD_DV_CS_ADOBE_YCC_601:   return ColorMatrix::Bt601Full;
+        case VHD_DV_CS_YUV709:
+        case VHD_DV_CS_XVYCC_709:       return ColorMatrix::Bt709Limited;
+        case VHD_DV_CS_YUV_709_FULL:    return ColorMatrix::Bt709Full;
+        case VHD_DV_CS_BT2020_YCCBCCRC:
+        case VHD_DV_CS_BT2020_YCBCR:    return ColorMatrix::Bt2020Limited;
+        default:                        break;
+        }
     }
+    const auto vc = Application::Helper::get_video_characteristics(signalInformation);
+    return vc.height > 0 && vc.height <= 576 ? ColorMatrix::Bt601Limited : ColorMatrix::Bt709Limited;
+}
 
-    // Vertical flipping reverses line parity when the output height is even.
-    const int outputFieldParity = flipY ? ((H - 1 - sourceParity) & 1) : sourceParity;
-    const int rowBytesBGRA = W * 4;
+// `detected` unless SetColorMatrix overrides it for the stream.
+static ColorMatrix StreamColorMatrix(int index, ColorMatrix detected)
+{
+    const unsigned int setting = colorMatrixSetting[index].load(std::memory_order_relaxed);
+    if (setting == UNITYDELTACAST_COLOR_MATRIX_AUTO || setting > unsigned(ColorMatrix::Count)) return detected;
+    return ColorMatrix(setting - 1);
+}
 
-    for (int y = 0; y < H; ++y) {
-        if ((y & 1) == outputFieldParity) continue;
+// Per-stream counters behind GetStreamStats, since the stream's capture
+// started. Each figure is written with relaxed atomics by the thread that owns
+// it; GetStreamStats only reads them, so collecting adds no lock anywhere.
+struct StreamCounters {
+    std::atomic<unsigned long long> captured{ 0 };      // slots popped from the board
+    std::atomic<unsigned long long> published{ 0 };
+    std::atomic<unsigned long long> consumed{ 0 };      // distinct frames fetched by a consumer
+    std::atomic<unsigned long long> lastConsumed{ 0 };  // seq of the newest of them
+    std::atomic<unsigned int> boardSlots{ 0 };          // filled slots left on the board by the last pop
+    std::atomic<double> publishToFetchMs{ 0.0 };        // exponentially averaged
+    std::atomic<double> captureCpuMs{ 0.0 };
+    std::atomic<double> conversionCpuMs{ 0.0 };
+    LatencyHistogram conversion;                        // wall time per converted frame
+};
 
-        int upY = y - 1;
-        int downY = y + 1;
-        if (upY < 0) upY = downY;
-        if (downY >= H) downY = upY;
+static StreamCounters streamCounters[4];
 
-        uint8_t* out = dst + size_t(y) * dstPitch;
-        const uint8_t* up = dst + size_t(upY) * dstPitch;
-        const uint8_t* down = dst + size_t(downY) * dstPitch;
+static void ResetStreamCounters(int index)
+{
+    StreamCounters& c = streamCounters[index];
+    c.captured.store(0, std::memory_order_relaxed);
+    c.published.store(0, std::memory_order_relaxed);
+    c.consumed.store(0, std::memory_order_relaxed);
+    c.lastConsumed.store(0, std::memory_order_relaxed);
+    c.boardSlots.store(0, std::memory_order_relaxed);
+    c.publishToFetchMs.store(0.0, std::memory_order_relaxed);
+    c.captureCpuMs.store(0.0, std::memory_order_relaxed);
+    c.conversionCpuMs.store(0.0, std::memory_order_relaxed);
+    c.conversion.Reset();
+}
 
-        if (upY == downY) {
-            std::memcpy(out, up, rowBytesBGRA);
-        }
-        else {
-            for (int i = 0; i < rowBytesBGRA; ++i) {
-                out[i] = uint8_t((int(up[i]) + int(down[i])) >> 1);
-            }
+// A consumer read frame `seq` of stream `index`.
+static void CountConsumed(int index, unsigned long long seq)
+{
+    StreamCounters& c = streamCounters[index];
+    unsigned long long last = c.lastConsumed.load(std::memory_order_relaxed);
+    while (seq > last) {
+        if (c.lastConsumed.compare_exchange_weak(last, seq, std::memory_order_relaxed)) {
+            c.consumed.fetch_add(1, std::memory_order_relaxed);
+            break;
         }
     }
 
-    return true;
+    const int64_t ns = frameTimings[index].MarkFetched(seq);
+    if (ns < 0) return;
+    constexpr double alpha = 1.0 / 16.0;
+    const double ms = double(ns) / 1e6;
+    const double prev = c.publishToFetchMs.load(std::memory_order_relaxed);
+    c.publishToFetchMs.store(prev == 0.0 ? ms : prev + alpha * (ms - prev), std::memory_order_relaxed);
 }
 
-//using TechStream = std::variant<Deltacast::Wrapper::SdiStream, Deltacast::Wrapper::DvStream>;
+// Per-stream conversion latency, exponentially averaged over recent frames.
+// wallMs is what the capture thread actually waited; serialMs is the summed band
+// time, i.e. what the same conversion costs on a single thread.
+struct ConversionStats {
+    std::atomic<double> wallMs{ 0.0 };
+    std::atomic<double> serialMs{ 0.0 };
+};
+
+static ConversionStats conversionStats[4];
+
+static void RecordConversionTiming(int index, const ConversionPool::Timing& timing)
+{
+    if (index < 0 || index >= 4) return;
+
+    constexpr double alpha = 1.0 / 16.0;
+    ConversionStats& st = conversionStats[index];
+    const double wall = double(timing.wallNs) / 1e6;
+    const double serial = double(timing.workNs) / 1e6;
+    streamCounters[index].conversion.Add(timing.wallNs);
+
+    // Single writer (the stream's capture thread), so load/store is enough.
+    const double prevWall = st.wallMs.load(std::memory_order_relaxed);
+    const double prevSerial = st.serialMs.load(std::memory_order_relaxed);
+    st.wallMs.store(prevWall == 0.0 ? wall : prevWall + alpha * (wall - prevWall), std::memory_order_relaxed);
+    st.serialMs.store(prevSerial == 0.0 ? serial : prevSerial + alpha * (serial - prevSerial), std::memory_order_relaxed);
+}
 
-static std::vector<uint8_t> sbsBGRA;  // combined (left|right) output
+//using TechStream = std::variant<Deltacast::Wrapper::SdiStream, Deltacast::Wrapper::DvStream>;
 
 // copy left & right BGRA images into a single side-by-side BGRA
 static void PackSideBySide_BGRA(const uint8_t* left, int LW, int LH, int LPitch,
@@ -293,84 +421,6 @@ static void PackSideBySide_BGRA(const uint8_t* left, int LW, int LH, int LPitch,
     }
 }
 
-// copy left & right BGRA images into a single side-by-side BGRA
-// with simple "bob" deinterlacing, using SDK-provided parity
-static void PackSideBySide_BGRA_deinterlaced(const uint8_t* left, int LW, int LH, int LPitch,
-    const uint8_t* right, int RW, int RH, int RPitch,
-    uint8_t* dst, int outW, int outH,
-    bool topFieldFirst)  
-{
-    const int outPitch = outW * 4;
-    const int leftBytesRow = LW * 4;
-    const int rightBytesRow = RW * 4;
-    const int rightOffset = LW * 4; // bytes to the start of the right image
-
-    for (int y = 0; y < outH; ++y) {
-        uint8_t* drow = dst + y * outPitch;
-
-        // ---------- LEFT ----------
-        if (y < LH) {
-            const uint8_t* crow = left + y * LPitch;
-
-            bool isFieldLine = ((y & 1) == 0);
-            if (!topFieldFirst) isFieldLine = !isFieldLine;  // flip if bottom-field-first
-
-            if (isFieldLine) {
-                // copy original field line
-                std::memcpy(drow, crow, leftBytesRow);
-            }
-            else {
-                // interpolate odd line
-                const int upY = (y > 0) ? (y - 1) : y;
-                const int dnY = (y + 1 < LH) ? (y + 1) : y;
-                const uint8_t* up = left + upY * LPitch;
-                const uint8_t* dn = left + dnY * LPitch;
-                for (int i = 0; i < leftBytesRow; ++i) {
-                    drow[i] = uint8_t((int(up[i]) + int(dn[i])) >> 1);
-                }
-            }
-        }
-        else {
-            std::memset(drow, 0, leftBytesRow);
-        }
-
-        // ---------- RIGHT ----------
-        uint8_t* drowR = drow + rightOffset;
-        if (y < RH) {
-            const uint8_t* crow = right + y * RPitch;
-
-            bool isFieldLine = ((y & 1) == 0);
-            if (!topFieldFirst) isFieldLine = !isFieldLine;
-
-            if (isFieldLine) {
-                std::memcpy(drowR, crow, rightBytesRow);
-            }
-            else {
-                const int upY = (y > 0) ? (y - 1) : y;
-                const int dnY = (y + 1 < RH) ? (y + 1) : y;
-                const uint8_t* up = right + upY * RPitch;
-                const uint8_t* dn = right + dnY * RPitch;
-                for (int i = 0; i < rightBytesRow; ++i) {
-                    drowR[i] = uint8_t((int(up[i]) + int(dn[i])) >> 1);
-                }
-            }
-        }
-        else {
-            std::memset(drowR, 0, rightBytesRow);
-        }
-    }
-}
-
-
-
-static void logHelper(const std::string& msg)
-{
-    std::lock_guard<std::mutex> lk(messageMutex);
-    if (message.size() < 2000) {
-        message += msg + "\n";
-    }
-}
-
 //void StartCaptureAuto(int device_id, int rx_stream_id, int buffer_depth)
 //{
 //    bool expected = false;
@@ -500,26 +550,26 @@ static const uint8_t DIGITS_3x5[10][5] = {
     {0b111, 0b101, 0b111, 0b001, 0b111}  // 9
 };
 
-static void SetPixelBGRA(uint8_t* img, int W, int H, int pitch, int x, int y,
-    uint8_t b, uint8_t g, uint8_t r, uint8_t a = 255)
-{
-    if (x < 0 || y < 0 || x >= W || y >= H) return;
-
-    uint8_t* p = img + y * pitch + x * 4;
-    p[0] = b;
-    p[1] = g;
-    p[2] = r;
-    p[3] = a;
-}
-
+// Clips the rectangle to the image once, then fills whole rows.
 static void FillRectBGRA(uint8_t* img, int W, int H, int pitch,
     int x0, int y0, int rw, int rh,
     uint8_t b, uint8_t g, uint8_t r, uint8_t a = 255)
 {
-    for (int y = y0; y < y0 + rh; ++y) {
-        for (int x = x0; x < x0 + rw; ++x) {
-            SetPixelBGRA(img, W, H, pitch, x, y, b, g, r, a);
-        }
+    const int x1 = std::min(x0 + rw, W);
+    const int y1 = std::min(y0 + rh, H);
+    x0 = std::max(x0, 0);
+    y0 = std::max(y0, 0);
+    if (x0 >= x1 || y0 >= y1) return;
+
+    uint8_t* first = img + size_t(y0) * pitch + size_t(x0) * 4;
+    for (int x = 0; x < x1 - x0; ++x) {
+        first[x * 4 + 0] = b;
+        first[x * 4 + 1] = g;
+        first[x * 4 + 2] = r;
+        first[x * 4 + 3] = a;
+    }
+    for (int y = y0 + 1; y < y1; ++y) {
+        std::memcpy(img + size_t(y) * pitch + size_t(x0) * 4, first, size_t(x1 - x0) * 4);
     }
 }
 
@@ -538,16 +588,10 @@ static void DrawDigit3x5BGRA(uint8_t* img, int W, int H, int pitch,
             bool on = (bits & (1 << (2 - col))) != 0;
             if (!on) continue;
 
-            for (int sy = 0; sy < scale; ++sy) {
-                for (int sx = 0; sx < scale; ++sx) {
-                    SetPixelBGRA(
-                        img, W, H, pitch,
-                        x0 + col * scale + sx,
-                        y0 + row * scale + sy,
-                        b, g, r, 255
-                    );
-                }
-            }
+            FillRectBGRA(img, W, H, pitch,
+                x0 + col * scale, y0 + row * scale,
+                scale, scale,
+                b, g, r, 255);
         }
     }
 }
@@ -609,25 +653,42 @@ static void BurnFrameNumberBGRA(uint8_t* img,
 
 // ============================ Recording (ffmpeg subprocess) ============================
 //
-// Per-stream recorder. A dedicated writer thread snapshots the already-converted BGRA
+// Per-stream recorder. A dedicated writer thread pins the already-converted BGRA
 // frame published for `index` (the same buffer Unity displays), paces it at a constant
-// fps, and pipes raw BGRA to an ffmpeg.exe child process. ffmpeg owns segmentation, so
+// fps, and pipes raw BGRA from that buffer to an ffmpeg.exe child process. ffmpeg owns segmentation, so
 // each .mov file is exactly fps*segmentSeconds frames (= exactly 1 minute by default).
 // `recordedFrame` is the synchronization currency Unity uses to key its .srt metadata.
+//
+// In the UYVY/NV12 modes the conversion thread additionally publishes the captured
+// frame in that format, top row first, to recordRings[index], and the writer pipes
+// those instead: 2 or 1.5 bytes per pixel instead of 4, and no vflip pass in ffmpeg.
+//
+// The child process and its pipe are a RecordPipe (CreateProcess on Windows,
+// posix_spawn and vmsplice on Linux). StartRecordingPipe replaces ffmpeg with any
+// command that reads the raw frames from stdin.
 
 struct RecorderCtx {
     std::atomic<bool> recording{ false };
     std::thread thread;
     std::atomic<unsigned long long> recordedFrame{ 0 };
+    std::atomic<int> backlog{ 0 };                      // frame periods the writer runs behind its schedule
+    std::atomic<unsigned long long> gapFills{ 0 };      // frames written again because no new one arrived
 
     // configuration captured at StartRecording (read by the writer thread after it starts,
     // which is synchronized by the std::thread construction that follows the writes)
     std::string ffmpegExe;
     std::string outputPattern;
     std::string encoderArgs;
+    std::string commandLine;        // StartRecordingPipe consumer; empty -> ffmpeg
     int fps = 30;
     int segmentSeconds = 60;
     bool vflip = true;
+    unsigned int pixelFormat = UNITYDELTACAST_RECORD_BGRA;
+
+    // Format the conversion thread must feed to recordRings (BGRA: none). Set by
+    // StartRecording, cleared when the writer finishes.
+    std::atomic<unsigned int> feed{ UNITYDELTACAST_RECORD_BGRA };
+    std::atomic<bool> feedWarned{ false };
 
     // resolution locked once the first frame is available
     int width = 0;
@@ -636,21 +697,46 @@ struct RecorderCtx {
 
 static RecorderCtx recorders[4];
 
+// UYVY/NV12 frames for recorders that are not fed BGRA; frame format tags are
+// UNITYDELTACAST_RECORD_*.
+static FrameRing recordRings[4];
+
+static const char* RecordPixelFormatName(unsigned int pixelFormat)
+{
+    switch (pixelFormat) {
+    case UNITYDELTACAST_RECORD_UYVY: return "uyvy422";
+    case UNITYDELTACAST_RECORD_NV12: return "nv12";
+    default:                         return "bgra";
+    }
+}
+
+static size_t RecordFrameBytes(unsigned int pixelFormat, int W, int H)
+{
+    switch (pixelFormat) {
+    case UNITYDELTACAST_RECORD_UYVY: return size_t(W) * size_t(H) * 2;
+    case UNITYDELTACAST_RECORD_NV12: return NV12FrameBytes(W, H);
+    default:                         return size_t(W) * size_t(H) * 4;
+    }
+}
+
 // Assemble the ffmpeg argument string, identical to the known-good Unity command.
 static std::string BuildFfmpegCommand(const RecorderCtx& r)
 {
+    // NV12 input goes to the encoder as is; anything else is converted to yuv420p.
     const std::string defaultEncoder =
-        "-c:v h264_nvenc -preset p1 -rc vbr -cq 22 -pix_fmt yuv420p -g "
-        + std::to_string(r.fps) + " -rgb_mode yuv420";
+        "-c:v h264_nvenc -preset p1 -rc vbr -cq 22 -pix_fmt "
+        + std::string(r.pixelFormat == UNITYDELTACAST_RECORD_NV12 ? "nv12" : "yuv420p")
+        + " -g " + std::to_string(r.fps) + " -rgb_mode yuv420";
     const std::string& encoder = r.encoderArgs.empty() ? defaultEncoder : r.encoderArgs;
 
     std::ostringstream cmd;
     cmd << "\"" << r.ffmpegExe << "\""
-        << " -y -f rawvideo -pixel_format bgra"
+        << " -y -f rawvideo -pixel_format " << RecordPixelFormatName(r.pixelFormat)
         << " -video_size " << r.width << "x" << r.height
         << " -framerate " << r.fps
         << " -i -";
-    if (r.vflip) cmd << " -vf vflip";
+    // Only the published BGRA frames are stored bottom-up.
+    if (r.vflip && r.pixelFormat == UNITYDELTACAST_RECORD_BGRA) cmd << " -vf vflip";
     cmd << " " << encoder
         << " -f segment -segment_time " << r.segmentSeconds
         << " -reset_timestamps 1 -segment_format mov"
@@ -658,90 +744,10 @@ static std::string BuildFfmpegCommand(const RecorderCtx& r)
     return cmd.str();
 }
 
-// Write the whole buffer to the pipe, tolerating partial writes.
-static bool WriteAllToPipe(HANDLE h, const uint8_t* data, size_t size)
-{
-    size_t off = 0;
-    while (off < size) {
-        DWORD chunk = (DWORD)std::min<size_t>(size - off, (size_t)(1u << 20));
-        DWORD written = 0;
-        if (!WriteFile(h, data + off, chunk, &written, nullptr) || written == 0) {
-            return false;
-        }
-        off += written;
-    }
-    return true;
-}
-
-// Launch ffmpeg with stdin = read end of a pipe and stderr/stdout -> a per-stream log file.
-// On success, fills hStdInWr (write end, owned by caller) and pi.
-static bool SpawnFfmpeg(RecorderCtx& r, HANDLE& hStdInWr, PROCESS_INFORMATION& pi)
-{
-    hStdInWr = nullptr;
-    ZeroMemory(&pi, sizeof(pi));
-
-    SECURITY_ATTRIBUTES sa{};
-    sa.nLength = sizeof(sa);
-    sa.bInheritHandle = TRUE;
-    sa.lpSecurityDescriptor = nullptr;
-
-    HANDLE hStdInRd = nullptr;
-    if (!CreatePipe(&hStdInRd, &hStdInWr, &sa, 0)) {
-        DC_LOG("rec: CreatePipe failed err=" + std::to_string(GetLastError()));
-        return false;
-    }
-    // The write end stays in the parent and must NOT be inherited by the child.
-    SetHandleInformation(hStdInWr, HANDLE_FLAG_INHERIT, 0);
-
-    // ffmpeg's diagnostics go to a log file next to the output (a file, not a pipe, so it
-    // can never deadlock on a full pipe). Fall back to NUL if the log can't be created.
-    const std::string logPath = r.outputPattern + ".ffmpeg.log";
-    HANDLE hLog = CreateFileA(logPath.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE,
-                              &sa, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
-    if (hLog == INVALID_HANDLE_VALUE) {
-        hLog = CreateFileA("NUL", GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE,
-                           &sa, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
-    }
-
-    STARTUPINFOA si{};
-    si.cb = sizeof(si);
-    si.dwFlags = STARTF_USESTDHANDLES;
-    si.hStdInput = hStdInRd;
-    si.hStdOutput = hLog;
-    si.hStdError = hLog;
-
-    const std::string cmd = BuildFfmpegCommand(r);
-    DC_LOG(std::string("rec: launching ffmpeg: ") + cmd);
-
-    // CreateProcessA needs a writable command-line buffer.
-    std::vector<char> cmdline(cmd.begin(), cmd.end());
-    cmdline.push_back('\0');
-
-    BOOL ok = CreateProcessA(
-        nullptr,            // lpApplicationName null -> search PATH using cmdline's first token
-        cmdline.data(),
-        nullptr, nullptr,
-        TRUE,               // inherit handles (pipe read end + log file)
-        CREATE_NO_WINDOW,
-        nullptr, nullptr,
-        &si, &pi);
-
-    // Parent's copies of the handles handed to the child.
-    CloseHandle(hStdInRd);
-    if (hLog != INVALID_HANDLE_VALUE) CloseHandle(hLog);
-
-    if (!ok) {
-        DC_LOG("rec: CreateProcess(ffmpeg) failed err=" + std::to_string(GetLastError()));
-        CloseHandle(hStdInWr);
-        hStdInWr = nullptr;
-        return false;
-    }
-    return true;
-}
-
 static void RecordWriterLoop(int index)
 {
     RecorderCtx& r = recorders[index];
+    Tracer::NameThread("recorder " + std::to_string(index));
 
     // 1) Wait for capture to publish a frame so we know the resolution.
     while (r.recording.load(std::memory_order_relaxed)) {
@@ -752,82 +758,765 @@ static void RecordWriterLoop(int index)
     }
     if (!r.recording.load(std::memory_order_relaxed)) return;
 
-    const size_t frameBytes = size_t(r.width) * size_t(r.height) * 4;
-
-    // 2) Launch ffmpeg now that -video_size is known.
-    HANDLE hStdInWr = nullptr;
-    PROCESS_INFORMATION pi{};
-    if (!SpawnFfmpeg(r, hStdInWr, pi)) {
+    const size_t frameBytes = RecordFrameBytes(r.pixelFormat, r.width, r.height);
+    FrameRing& source = r.pixelFormat == UNITYDELTACAST_RECORD_BGRA ? frameRings[index] : recordRings[index];
+    bool formatWarned = false;
+
+    // 2) Launch ffmpeg (or the caller's consumer) now that -video_size is known.
+    // ffmpeg's diagnostics go to a log file next to the output.
+    const std::string cmd = r.commandLine.empty() ? BuildFfmpegCommand(r) : r.commandLine;
+    DC_LOG("rec: launching: {}", cmd);
+    // The writer pins FramesInPipe() + 1 frames; the producer needs the latest and
+    // a free buffer, and Unity may hold a lent one.
+    constexpr size_t kMaxFramesInPipe = FrameRing::kBuffers - 3;
+    static_assert(kMaxFramesInPipe >= 1, "FrameRing too small for zero-copy recording");
+    RecordPipe pipe;
+    if (!pipe.Open(cmd, r.commandLine.empty() ? r.outputPattern + ".ffmpeg.log" : std::string(), frameBytes,
+                   kMaxFramesInPipe)) {
+        r.feed.store(UNITYDELTACAST_RECORD_BGRA, std::memory_order_relaxed);
         r.recording.store(false, std::memory_order_relaxed);
         return;
     }
 
     // 3) Constant-fps write loop with gap-fill (repeat last frame) to hold the rate.
-    timeBeginPeriod(1);
+    FramePacer pacer;
     const auto t0 = std::chrono::steady_clock::now();
     const double interval = 1.0 / double(r.fps);
 
-    std::vector<uint8_t> last;   // most recent snapshot; reused as the gap-fill source
-    bool haveLast = false;
-    unsigned long long lastCapturedSeen = 0;  // last capture-frame counter we copied
+    // Frames the writer keeps pinned in `source`: the newest one, written again as the
+    // gap-fill, and older ones the pipe may still reference (vmsplice), each with the
+    // index of its last write. Pinning never stalls the producer; it writes another buffer.
+    struct HeldFrame {
+        FrameRing::Frame* frame;
+        unsigned long long lastWrite;
+    };
+    std::deque<HeldFrame> held;
+    unsigned long long lastCapturedSeen = 0;  // sequence number of the newest held frame
     unsigned long long nextIdx = 0;
     bool resolutionChanged = false;
 
     while (r.recording.load(std::memory_order_relaxed)) {
         const auto target = t0 + std::chrono::nanoseconds(
             (long long)(double(nextIdx) * interval * 1e9));
-        std::this_thread::sleep_until(target);
-
-        // Only copy when capture produced a new frame; otherwise reuse `last` (gap-fill) without
-        // taking the lock. nativeFrameCounter is updated immediately after each publish, so its
-        // release/acquire ordering makes it a cheap, lock-free "new frame available" signal.
+        pacer.SleepUntil(target);
+        // ffmpeg draining the pipe slower than real time shows up as lateness here.
+        r.backlog.store(int(std::chrono::duration<double>(std::chrono::steady_clock::now() - target).count() / interval),
+                        std::memory_order_relaxed);
+        bool newFrame = false;
+
+        // Only pin when capture produced a new frame; otherwise rewrite the newest held one
+        // (gap-fill). nativeFrameCounter is updated immediately after each publish, so its
+        // release/acquire ordering makes it a cheap "new frame available" signal.
+        // The YUV frames are published right after the counter, so track the
+        // sequence number of the frame actually pinned.
         const unsigned long long captured = nativeFrameCounter[index].load(std::memory_order_acquire);
         if (captured != lastCapturedSeen) {
-            std::lock_guard<std::mutex> lk(frameMutex[index]);
-            const size_t avail = latestFrame[index].size();
-            if (avail == frameBytes) {
-                last.assign(latestFrame[index].begin(), latestFrame[index].end());
-                haveLast = true;
-                lastCapturedSeen = captured;
-            }
-            else if (avail != 0) {
-                resolutionChanged = true;  // signal change mid-recording -> stop cleanly
+            FrameRing::Frame* frame = source.Acquire();
+            if (frame) {
+                bool keep = false;
+                const unsigned long long seq = frame->seq.load(std::memory_order_relaxed);
+                const size_t avail = frame->data.size();
+                if (&source == &frameRings[index] && frame->format != UNITYDELTACAST_OUTPUT_BGRA8) {
+                    // SetOutputFormat switched Unity's frames away from BGRA8: keep gap-filling.
+                    if (!formatWarned) {
+                        DC_LOG("rec: published frames are not BGRA8, index={}", index);
+                        formatWarned = true;
+                    }
+                }
+                else if (seq == lastCapturedSeen) {
+                    // Newer frame not fed to recordRings yet.
+                }
+                else if (avail == frameBytes) {
+                    held.push_back({ frame, nextIdx });
+                    keep = true;
+                    newFrame = true;
+                    lastCapturedSeen = seq;
+                }
+                else if (avail != 0) {
+                    resolutionChanged = true;  // signal change mid-recording -> stop cleanly
+                }
+                if (!keep) source.Release(frame);
             }
         }
 
         if (resolutionChanged) {
-            DC_LOG("rec: resolution changed mid-recording, stopping index=" + std::to_string(index));
+            DC_LOG("rec: resolution changed mid-recording, stopping index={}", index);
             break;
         }
 
-        if (!haveLast) {
+        if (held.empty()) {
             // No frame captured yet; don't advance the frame index (keeps fps honest).
             continue;
         }
 
-        if (!WriteAllToPipe(hStdInWr, last.data(), last.size())) {
-            DC_LOG("rec: pipe write failed (ffmpeg gone?) index=" + std::to_string(index));
+        // Straight from the ring buffer: the frame is never copied by the writer.
+        TraceScope writeScope("pipe_write", lastCapturedSeen);
+        if (!pipe.Write(held.back().frame->data.data())) {
+            DC_LOG("rec: pipe write failed (ffmpeg gone?) index={}", index);
             break;
         }
+        writeScope.End();
+        held.back().lastWrite = nextIdx;
         r.recordedFrame.fetch_add(1, std::memory_order_relaxed);
+        if (!newFrame) r.gapFills.fetch_add(1, std::memory_order_relaxed);
         ++nextIdx;
-    }
 
-    timeEndPeriod(1);
+        // Unpin older frames once enough later frames pushed them out of the pipe.
+        while (held.size() > 1 && nextIdx - held.front().lastWrite > pipe.FramesInPipe()) {
+            source.Release(held.front().frame);
+            held.pop_front();
+        }
+    }
 
     // 4) Teardown: closing stdin tells ffmpeg to flush and finalize the last segment.
-    if (hStdInWr) { CloseHandle(hStdInWr); hStdInWr = nullptr; }
-    if (pi.hProcess) {
-        WaitForSingleObject(pi.hProcess, INFINITE);
-        CloseHandle(pi.hProcess);
-    }
-    if (pi.hThread) CloseHandle(pi.hThread);
+    // The child has exited, so the pipe no longer references the held frames.
+    pipe.Close();
+    for (const HeldFrame& h : held) source.Release(h.frame);
 
+    r.feed.store(UNITYDELTACAST_RECORD_BGRA, std::memory_order_relaxed);
     r.recording.store(false, std::memory_order_relaxed);
-    DC_LOG("rec: writer finished index=" + std::to_string(index)
-        + " frames=" + std::to_string(r.recordedFrame.load()));
+    DC_LOG("rec: writer finished index={} frames={}", index, r.recordedFrame.load());
+}
+
+// Claims recorders[index] and starts its writer thread. An empty `commandLine`
+// launches ffmpeg from the other settings. Returns 0 if already recording.
+static int StartRecorder(int index, const std::string& ffmpegExe, const std::string& outputPattern, int fps,
+                         int segmentSeconds, const std::string& encoderArgs, bool vflip, unsigned int pixelFormat,
+                         const std::string& commandLine)
+{
+    if (fps <= 0) fps = 30;
+    if (segmentSeconds <= 0) segmentSeconds = 60;
+
+    RecorderCtx& r = recorders[index];
+
+    bool expected = false;
+    if (!r.recording.compare_exchange_strong(expected, true)) {
+        return 0; // already recording
+    }
+
+    // A previous session may have stopped on its own (e.g. resolution change) without
+    // StopRecording() being called yet; join its finished thread before reusing the slot.
+    if (r.thread.joinable()) r.thread.join();
+
+    r.recordedFrame.store(0, std::memory_order_relaxed);
+    r.backlog.store(0, std::memory_order_relaxed);
+    r.gapFills.store(0, std::memory_order_relaxed);
+    r.ffmpegExe = ffmpegExe;
+    r.outputPattern = outputPattern;
+    r.encoderArgs = encoderArgs;
+    r.commandLine = commandLine;
+    r.fps = fps;
+    r.segmentSeconds = segmentSeconds;
+    r.vflip = vflip;
+    r.pixelFormat = (pixelFormat == UNITYDELTACAST_RECORD_UYVY || pixelFormat == UNITYDELTACAST_RECORD_NV12)
+        ? pixelFormat : UNITYDELTACAST_RECORD_BGRA;
+    r.width = 0;
+    r.height = 0;
+
+    // Frames fed to a previous recording must not be written again.
+    recordRings[index].Reset();
+    r.feedWarned.store(false, std::memory_order_relaxed);
+    r.feed.store(r.pixelFormat, std::memory_order_relaxed);
+
+    r.thread = std::thread(RecordWriterLoop, index);
+    return 1;
+}
+
+static void LogCaptureLayout(const CaptureLayout& layout, VHD_BUFFERPACKING requested)
+{
+    if (layout.rgb) {
+        DC_LOG("source packing={}{}{}", RgbPackingName(layout.rgbPacking),
+            layout.rgbLimitedRange ? " (limited range)" : "",
+            layout.bufferPacking != requested ? ", RGB signal" : "");
+        return;
+    }
+    if (layout.packing == SourcePacking::UYVY8 && requested != VHD_BUFPACK_VIDEO_YUV422_8) {
+        DC_LOG("buffer_packing={} is not a 4:2:2 packing the converter reads; converting as YUV422_8", int(requested));
+    }
+    DC_LOG("source packing={}", SourcePackingName(layout.packing));
+}
+
+// ---- Slot drain / conversion stages ----
+// The capture thread only pops slots and queues them; a per-stream conversion
+// thread converts and publishes. A slow conversion then backs up this queue,
+// where the configured policy decides what to drop, instead of stalling
+// pop_slot() and overflowing the board's slot queue.
+struct CapturedSlot {
+    std::unique_ptr<Slot> slot;     // released back to the board on destruction
+    int width = 0;
+    int height = 0;
+    bool fieldMode = false;
+    bool motionAdaptive = false;    // field mode through deinterlacers[], else bob
+    SourcePacking packing = SourcePacking::UYVY8;
+    OutputFormat format = OutputFormat::BGRA8;
+    ColorMatrix matrix = ColorMatrix::Bt601Limited;
+    bool raw = false;               // publish the UYVY payload unconverted
+    bool rgb = false;               // RGB 4:4:4 (rgbPacking), reordered to BGRA8 without a matrix
+    RgbPacking rgbPacking = RgbPacking::RGB24;
+    bool rgbLimitedRange = false;
+    unsigned long long frameNo = 0; // on-demand mode: numbered when parked, else 0
+    bool afterDrain = false;        // NEWEST mode released older slots just before this one
+    std::chrono::steady_clock::time_point capturedAt; // estimated time the board filled the slot
+    std::chrono::steady_clock::time_point poppedAt;
+};
+
+static SlotQueue<CapturedSlot> slotQueues[4];
+// Field history of the motion-adaptive field mode, used by the conversion thread.
+static MotionAdaptiveDeinterlacer deinterlacers[4];
+static std::atomic<unsigned int> slotQueuePolicy[4] = {
+    UNITYDELTACAST_SLOT_QUEUE_DROP_OLDEST, UNITYDELTACAST_SLOT_QUEUE_DROP_OLDEST,
+    UNITYDELTACAST_SLOT_QUEUE_DROP_OLDEST, UNITYDELTACAST_SLOT_QUEUE_DROP_OLDEST
+};
+static std::atomic<int> slotQueueCapacity[4] = { 2, 2, 2, 2 };
+static std::atomic<unsigned long long> boardSlotsDropped[4] = { 0, 0, 0, 0 };
+
+// Per-stream SetConversionMode mode, read by the conversion thread per slot.
+static std::atomic<unsigned int> conversionMode[4] = {
+    UNITYDELTACAST_CONVERSION_EAGER, UNITYDELTACAST_CONVERSION_EAGER,
+    UNITYDELTACAST_CONVERSION_EAGER, UNITYDELTACAST_CONVERSION_EAGER
+};
+
+// Every conversion into frameRings[index] of a StartCapture stream runs under
+// `mutex`, so the ring keeps a single producer although in the on-demand mode
+// the consumer's thread converts. `slot` is the parked newest slot of that mode.
+struct PendingFrame {
+    std::mutex mutex;
+    std::unique_ptr<CapturedSlot> slot;
+    std::atomic<bool> parked{ false };          // slot != nullptr, readable without the lock
+    unsigned long long lastConverted = 0;       // frameNo of the last converted slot
+    std::atomic<unsigned long long> converted{ 0 };
+    std::atomic<unsigned long long> skipped{ 0 };   // parked slots replaced unconverted
+};
+static PendingFrame pendingFrames[4];
+
+// Per-stream SetLatencyMode mode, read when a capture starts.
+static std::atomic<unsigned int> latencyMode[4] = {
+    UNITYDELTACAST_LATENCY_QUEUED, UNITYDELTACAST_LATENCY_QUEUED,
+    UNITYDELTACAST_LATENCY_QUEUED, UNITYDELTACAST_LATENCY_QUEUED
+};
+
+// Capture-to-publish age of the frames published by a StartCapture stream: the
+// latest one, and exponentially averaged like ConversionStats. Written under
+// pendingFrames[index].mutex, so load/store is enough.
+struct FrameAgeStats {
+    std::atomic<double> lastMs{ 0.0 };
+    std::atomic<double> averageMs{ 0.0 };
+    std::atomic<unsigned long long> drained{ 0 };   // slots the NEWEST mode released unconverted
+};
+static FrameAgeStats frameAges[4];
+
+static void RecordFrameAge(int index, std::chrono::steady_clock::time_point captured)
+{
+    constexpr double alpha = 1.0 / 16.0;
+    FrameAgeStats& st = frameAges[index];
+    const double age = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - captured).count();
+    const double prev = st.averageMs.load(std::memory_order_relaxed);
+    st.lastMs.store(age, std::memory_order_relaxed);
+    st.averageMs.store(prev == 0.0 ? age : prev + alpha * (age - prev), std::memory_order_relaxed);
+}
+
+// Time between two slots of a signal: a frame, or a field in field mode.
+static std::chrono::steady_clock::duration SlotPeriod(unsigned int framerate, bool fieldMode)
+{
+    if (framerate == 0) return std::chrono::steady_clock::duration::zero();
+    const double seconds = 1.0 / (double(framerate) * (fieldMode ? 2.0 : 1.0));
+    return std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds));
+}
+
+// Interval at which a capture session's SignalMonitor re-reads signal presence
+// and format (SetSignalPollInterval); read when a capture starts.
+static std::atomic<int> signalPollIntervalMs{ 100 };
+
+// Signal monitor probe for one RX: presence from the connector, format from the stream.
+static SignalMonitor<SignalInformation>::Probe MakeSignalProbe(Board& board, int rxIndex, Application::Helper::TechStream& stream)
+{
+    return [&board, rxIndex, &stream](SignalInformation& info) {
+        if (!board.rx(rxIndex).signal_present()) return false;
+        info = Application::Helper::detect_information(stream);
+        return true;
+    };
 }
 
+// Publishes the captured frame to recordRings[index] in the format a running
+// recorder is fed, top row first. Field-mode slots are bob-expanded (also in
+// the motion-adaptive mode, whose field history belongs to the published frames). Only 8-bit UYVY captures can feed the YUV recorder modes.
+static void FeedRecorder(int index, const CapturedSlot& captured, const uint8_t* src,
+                         size_t totalBytes, unsigned long long frameNo)
+{
+    RecorderCtx& r = recorders[index];
+    const unsigned int feed = r.feed.load(std::memory_order_relaxed);
+    if (feed == UNITYDELTACAST_RECORD_BGRA) return;
+    TraceScope scope("record_feed", frameNo);
+
+    if (captured.rgb || captured.packing != SourcePacking::UYVY8) {
+        if (!r.feedWarned.exchange(true, std::memory_order_relaxed)) {
+            DC_LOG("rec: UYVY/NV12 recording needs YUV422_8 packing, index={}", index);
+        }
+        return;
+    }
+
+    const int W = captured.width;
+    const int H = captured.height;
+    const bool nv12 = (feed == UNITYDELTACAST_RECORD_NV12);
+    FrameRing::Frame* frame = recordRings[index].BeginWrite(W, H, nv12 ? W : W * 2, feed,
+                                                            RecordFrameBytes(feed, W, H));
+    if (!frame) return;
+    uint8_t* dst = frame->data.data();
+
+    // Full-height UYVY source: the slot itself, or its bob-expanded field (written
+    // straight into the frame for the UYVY feed).
+    const uint8_t* uyvy = src;
+    int uyvyPitch = int(totalBytes / H);
+    if (captured.fieldMode) {
+        thread_local std::vector<uint8_t> expanded;
+        uint8_t* target = dst;
+        if (nv12) {
+            expanded.resize(size_t(W) * 2 * H);
+            target = expanded.data();
+        }
+        const bool evenField = (captured.slot->parity() == Slot::Parity::EVEN);
+        ConversionPool::Timing unused;
+        if (!Convert422_Field_Bob(SourcePacking::UYVY8, OutputFormat::BGRA8, captured.matrix, true, src, totalBytes,
+                                  target, W * 2, W, H, evenField, false, unused)) {
+            return;
+        }
+        uyvy = target;
+        uyvyPitch = W * 2;
+    }
+
+    if (nv12) {
+        UYVY_to_NV12(uyvy, uyvyPitch, dst, W, dst + size_t(W) * H, W, W, H);
+    }
+    else if (uyvy != dst) {
+        for (int y = 0; y < H; ++y) {
+            std::memcpy(dst + size_t(y) * W * 2, uyvy + size_t(y) * uyvyPitch, size_t(W) * 2);
+        }
+    }
+    recordRings[index].Publish(frame, frameNo);
+}
+
+static void ConvertAndPublish(int index, CapturedSlot& captured)
+{
+    auto [src, totalBytes] = captured.slot->video().buffer();
+    const int W = captured.width;
+    const int H = captured.height;
+    // Raw frames keep the board's row pitch; a bob-expanded field has no padding.
+    const int dstPitch = !captured.raw ? W * OutputBytesPerPixel(captured.format)
+        : captured.fieldMode ? W * 2
+        : int(totalBytes / H);
+    const unsigned int publishFormat = captured.raw ? UNITYDELTACAST_OUTPUT_UYVY8
+        : captured.format == OutputFormat::RGBA16 ? UNITYDELTACAST_OUTPUT_RGBA16
+        : UNITYDELTACAST_OUTPUT_BGRA8;
+    ConversionPool::Timing conversionTiming;
+
+    // On-demand frames were numbered (and counted) when they were parked.
+    const bool numbered = captured.frameNo != 0;
+    const unsigned long long frameNo = numbered ? captured.frameNo
+        : nativeFrameCounter[index].load(std::memory_order_relaxed) + 1;
+    TraceScope convertScope("convert", frameNo);
+
+    // Convert straight into a buffer no reader is looking at.
+    FrameRing::Frame* frame = frameRings[index].BeginWrite(W, H, dstPitch, publishFormat, size_t(dstPitch) * H);
+    if (!frame) {
+        // Readers pin every buffer of Unity's ring (counted by its Dropped()). The
+        // UYVY/NV12 recorder has its own ring, so it still gets the frame.
+        convertScope.End();
+        if (!numbered) nativeFrameCounter[index].store(frameNo, std::memory_order_release);
+        FeedRecorder(index, captured, src, totalBytes, frameNo);
+        return;
+    }
+
+    if (captured.fieldMode) {
+        const bool evenField = (captured.slot->parity() == Slot::Parity::EVEN);
+        // Fields released by a drain break the temporal sequence the field history weaves.
+        if (captured.afterDrain && captured.motionAdaptive) deinterlacers[index].Reset();
+        const bool ok = captured.motionAdaptive && captured.packing == SourcePacking::UYVY8
+            ? deinterlacers[index].Process(
+                captured.format,
+                captured.matrix,
+                captured.raw,
+                src,
+                totalBytes,
+                frame->data.data(),
+                dstPitch,
+                W,
+                H,
+                evenField,
+                !captured.raw,
+                conversionTiming)
+            : Convert422_Field_Bob(
+                captured.packing,
+                captured.format,
+                captured.matrix,
+                captured.raw,
+                src,
+                totalBytes,
+                frame->data.data(),
+                dstPitch,
+                W,
+                H,
+                evenField,
+                !captured.raw,
+                conversionTiming);
+        if (!ok) {
+            DC_LOG("field mode bob: unexpected field buffer size={}", totalBytes);
+            return;
+        }
+    }
+    else if (captured.raw) {
+        // The payload as the board delivered it, top row first.
+        const auto t0 = std::chrono::steady_clock::now();
+        std::memcpy(frame->data.data(), src, size_t(dstPitch) * H);
+        conversionTiming.wallNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - t0).count();
+        conversionTiming.workNs = conversionTiming.wallNs;
+    }
+    else if (captured.rgb) {
+        conversionTiming = ConvertRGB_Parallel(captured.rgbPacking, captured.rgbLimitedRange,
+            src, int(totalBytes / H), frame->data.data(), dstPitch, W, H, true);
+    }
+    else {
+        // Derive source pitch for the legacy full-frame path.
+        int srcPitch = int(totalBytes / H);
+        conversionTiming = Convert422_Parallel(captured.packing, captured.format, captured.matrix,
+            src, srcPitch, frame->data.data(), dstPitch, W, H, true);
+    }
+    convertScope.End();
+    const int64_t convertedNs = FrameTimingLog::Now();
+    RecordConversionTiming(index, conversionTiming);
+    if (!captured.raw) {
+        activeColorMatrix[index].store(captured.rgb ? UNITYDELTACAST_COLOR_MATRIX_AUTO : unsigned(captured.matrix) + 1,
+                                       std::memory_order_relaxed);
+    }
+
+    // The burn-in digits are drawn in BGRA8 only.
+    if (publishFormat == UNITYDELTACAST_OUTPUT_BGRA8 && burnInFrameNumber[index].load(std::memory_order_relaxed)) {
+        TraceScope scope("burn_in", frameNo);
+        BurnFrameNumberBGRA(
+            frame->data.data(),
+            W,
+            H,
+            dstPitch,
+            frameNo,
+            0,
+            W,
+            true
+        );
+    }
+    TraceScope publishScope("publish", frameNo);
+    frameRings[index].Publish(frame, frameNo);  // hand BGRA to Unity
+    streamCounters[index].published.fetch_add(1, std::memory_order_relaxed);
+    if (captured.capturedAt.time_since_epoch().count() != 0) {
+        FrameTimingLog::Stamps stamps;
+        stamps.ns[FrameTimingLog::Captured] = FrameTimingLog::ToNs(captured.capturedAt);
+        stamps.ns[FrameTimingLog::Popped] = FrameTimingLog::ToNs(captured.poppedAt);
+        stamps.ns[FrameTimingLog::Converted] = convertedNs;
+        stamps.ns[FrameTimingLog::Published] = FrameTimingLog::Now();
+        frameTimings[index].Record(frameNo, stamps);
+        RecordFrameAge(index, captured.capturedAt);
+    }
+
+    // Publish the counter only after the frame is visible. The recorder's
+    // acquire load then cannot associate a new counter with the old pixels.
+    if (!numbered) nativeFrameCounter[index].store(frameNo, std::memory_order_release);
+    publishScope.End();
+
+    FeedRecorder(index, captured, src, totalBytes, frameNo);
+}
+
+// ---- On-demand conversion ----
+// The conversion thread parks the newest slot instead of converting it; the
+// first consumer that asks for a frame (GetFrame*, AcquireFrame, GetFrameFormat)
+// converts it on its own thread and publishes it to frameRings[index], where
+// later consumers find it. Slots nobody asked for go back to the board
+// unconverted. A running recorder consumes every frame, so it keeps the stream
+// converting eagerly.
+
+static bool ConvertsOnDemand(int index)
+{
+    return conversionMode[index].load(std::memory_order_relaxed) == UNITYDELTACAST_CONVERSION_ON_DEMAND
+        && !recorders[index].recording.load(std::memory_order_relaxed);
+}
+
+// Converts the parked slot, if any. Releases the slot under the lock, so the
+// capture thread's Pause() (which takes it too) knows no slot is in use.
+static void ConvertPendingFrame(int index)
+{
+    PendingFrame& p = pendingFrames[index];
+    if (!p.parked.load(std::memory_order_acquire)) return;
+
+    std::lock_guard<std::mutex> lk(p.mutex);
+    if (!p.slot) return;
+    // The motion-adaptive history only holds consecutive fields.
+    if (p.slot->motionAdaptive && p.slot->frameNo != p.lastConverted + 1) {
+        deinterlacers[index].Reset();
+    }
+    ConvertAndPublish(index, *p.slot);
+    p.lastConverted = p.slot->frameNo;
+    p.converted.fetch_add(1, std::memory_order_relaxed);
+    p.slot.reset();
+    p.parked.store(false, std::memory_order_release);
+}
+
+// Drops the parked slot (mode switched to eager, capture stopping).
+static void DropPendingFrame(int index)
+{
+    PendingFrame& p = pendingFrames[index];
+    std::lock_guard<std::mutex> lk(p.mutex);
+    p.slot.reset();
+    p.parked.store(false, std::memory_order_release);
+}
+
+// Parks `captured` as the newest frame, releasing the one it replaces, and
+// makes its number visible through nativeFrameCounter.
+static void ParkFrame(int index, std::unique_ptr<CapturedSlot> captured)
+{
+    PendingFrame& p = pendingFrames[index];
+    const unsigned long long frameNo = nativeFrameCounter[index].load(std::memory_order_relaxed) + 1;
+    captured->frameNo = frameNo;
+    {
+        std::lock_guard<std::mutex> lk(p.mutex);
+        if (p.slot) p.skipped.fetch_add(1, std::memory_order_relaxed);
+        p.slot = std::move(captured);
+        p.parked.store(true, std::memory_order_release);
+    }
+    nativeFrameCounter[index].store(frameNo, std::memory_order_release);
+}
+
+// Conversion thread of one capture session. Pause() lets the capture thread stop
+// or reconfigure the RX stream: it returns once the conversion thread holds no
+// slot and the queue is empty. `busy` and `paused` form a Dekker-style handshake
+// (conversion: set busy, then check paused; capture: set paused, then check busy).
+class ConversionStage {
+public:
+    explicit ConversionStage(int index) : index(index), thread([this] { Loop(); }) {}
+
+    ~ConversionStage()
+    {
+        active.store(false, std::memory_order_relaxed);
+        slotQueues[index].Wake();
+        if (thread.joinable()) thread.join();
+        slotQueues[index].Clear();
+        DropPendingFrame(index);
+    }
+
+    void Pause()
+    {
+        paused.store(true, std::memory_order_seq_cst);
+        slotQueues[index].Wake();
+        while (busy.load(std::memory_order_seq_cst)) {
+            std::this_thread::yield();
+        }
+        slotQueues[index].Clear();
+        DropPendingFrame(index);
+    }
+
+    void Resume() { paused.store(false, std::memory_order_seq_cst); }
+
+private:
+    void Loop()
+    {
+        Tracer::NameThread("convert " + std::to_string(index));
+        SlotQueue<CapturedSlot>& queue = slotQueues[index];
+        while (active.load(std::memory_order_relaxed)) {
+            busy.store(true, std::memory_order_seq_cst);
+            if (paused.load(std::memory_order_seq_cst)) {
+                busy.store(false, std::memory_order_seq_cst);
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                continue;
+            }
+
+            if (std::unique_ptr<CapturedSlot> captured = queue.WaitPop(std::chrono::milliseconds(10))) {
+                if (ConvertsOnDemand(index)) {
+                    ParkFrame(index, std::move(captured));
+                }
+                else {
+                    DropPendingFrame(index);
+                    std::lock_guard<std::mutex> lk(pendingFrames[index].mutex);
+                    ConvertAndPublish(index, *captured);
+                }
+                streamCounters[index].conversionCpuMs.store(ThreadCpuMs(), std::memory_order_relaxed);
+            }
+            busy.store(false, std::memory_order_seq_cst);
+        }
+    }
+
+    const int index;
+    std::atomic<bool> active{ true };
+    std::atomic<bool> paused{ false };
+    std::atomic<bool> busy{ false };
+    std::thread thread;     // last member: starts after the flags are initialized
+};
+
+// ---- Mosaic capture ----
+// Every input has its own capture thread that keeps only its newest slot queued;
+// the session thread composes whatever is new into one frame (ComposeMosaic) as
+// soon as any input delivers, so no input sets the pace of the others.
+struct MosaicSlot {
+    std::unique_ptr<Slot> slot;     // released back to the board on destruction
+    int width = 0;
+    int height = 0;
+    ColorMatrix matrix = ColorMatrix::Bt601Limited;     // detected from the input's signal
+};
+
+struct MosaicInput {
+    int deviceId = 0;
+    int rxStreamId = 0;
+    SlotQueue<MosaicSlot> queue{ 1 };
+    // Held by the compositor while it converts a slot of this input, and by the
+    // input thread while it stops or closes the stream, so a slot in use always
+    // belongs to a running stream.
+    std::mutex streamMutex;
+    std::thread thread;
+};
+
+// Counts the slots queued by all inputs of a mosaic; the compositor waits for
+// the count to move instead of waiting on one input's queue.
+struct MosaicArrivals {
+    void Signal()
+    {
+        {
+            std::lock_guard<std::mutex> lk(mutex);
+            ++pushed;
+        }
+        cv.notify_one();
+    }
+
+    // Waits up to `timeout` for a slot queued after `seen`, then updates `seen`.
+    void Wait(unsigned long long& seen, std::chrono::milliseconds timeout)
+    {
+        std::unique_lock<std::mutex> lk(mutex);
+        cv.wait_for(lk, timeout, [&] { return pushed != seen; });
+        seen = pushed;
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable cv;
+    unsigned long long pushed = 0;
+};
+
+// UNITYDELTACAST_MOSAIC_* -> rows x columns of tiles.
+static bool GetMosaicGrid(unsigned int layout, int& rows, int& columns)
+{
+    switch (layout) {
+    case UNITYDELTACAST_MOSAIC_1X2: rows = 1; columns = 2; return true;
+    case UNITYDELTACAST_MOSAIC_2X1: rows = 2; columns = 1; return true;
+    case UNITYDELTACAST_MOSAIC_2X2: rows = 2; columns = 2; return true;
+    case UNITYDELTACAST_MOSAIC_3X3: rows = 3; columns = 3; return true;
+    default:                        return false;
+    }
+}
+
+static void MosaicInputLoop(int index, int tile, MosaicInput& input, MosaicArrivals& arrivals,
+                            const std::atomic<bool>& active, int buffer_depth)
+{
+    const std::string tag = "mosaic " + std::to_string(index) + " input " + std::to_string(tile) + ": ";
+    Tracer::NameThread("mosaic " + std::to_string(index) + " input " + std::to_string(tile));
+    bool started = false;
+    try {
+        auto board = Board::open(input.deviceId, nullptr);
+        auto rx_tech_stream = Application::Helper::open_stream(board, Application::Helper::rx_index_to_streamtype(input.rxStreamId));
+        auto& rx_stream = Application::Helper::to_base_stream(rx_tech_stream);
+
+        // Declared after the stream so queued slots are dropped before it closes,
+        // also on exceptions.
+        struct Drain {
+            MosaicInput& input;
+            ~Drain()
+            {
+                std::lock_guard<std::mutex> lk(input.streamMutex);
+                input.queue.Clear();
+            }
+        } drain{ input };
+
+        while (active.load() && !board.rx(input.rxStreamId).signal_present()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        if (!active.load()) return;
+
+        SignalInformation signal_information = Application::Helper::detect_information(rx_tech_stream);
+        int W = 0;
+        int H = 0;
+        ColorMatrix matrix = ColorMatrix::Bt601Limited;
+        auto configure = [&] {
+            const auto vc = Application::Helper::get_video_characteristics(signal_information);
+            W = vc.width;
+            H = vc.height;
+            matrix = DetectColorMatrix(signal_information);
+            rx_stream.buffer_queue().set_depth(buffer_depth);
+            rx_stream.set_buffer_packing(VHD_BUFPACK_VIDEO_YUV422_8);
+            Application::Helper::configure_stream(rx_tech_stream, signal_information);
+            DC_LOG("{}{}", tag, Application::Helper::get_information_string(signal_information, "[Video] "));
+        };
+
+        // Interlaced inputs are captured as merged frames, like the stereo path.
+        rx_stream.enable_field_merge();
+        configure();
+        rx_stream.start();
+        started = true;
+
+        const auto probe = MakeSignalProbe(board, input.rxStreamId, rx_tech_stream);
+        const std::chrono::milliseconds pollInterval(signalPollIntervalMs.load());
+        SignalMonitor<SignalInformation> monitor;
+        monitor.Start(probe, signal_information, pollInterval);
+
+        SignalInformation cur;
+        while (active.load()) {
+            if (!monitor.SignalPresent()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                continue;
+            }
+            if (monitor.Changed(cur)) {
+                // No probing while the stream is reconfigured.
+                monitor.Stop();
+                {
+                    std::lock_guard<std::mutex> lk(input.streamMutex);
+                    input.queue.Clear();
+                    rx_stream.stop();
+                    started = false;
+                }
+                signal_information = cur;
+                configure();
+                rx_stream.start();
+                started = true;
+                monitor.Start(probe, signal_information, pollInterval);
+                continue;
+            }
+
+            std::unique_ptr<Slot> slot;
+            try {
+                TraceScope scope("pop_slot");
+                slot = rx_stream.pop_slot();
+            }
+            catch (const ApiException&) {
+                if (board.rx(input.rxStreamId).signal_present()) throw;
+                continue;
+            }
+            streamCounters[index].captured.fetch_add(1, std::memory_order_relaxed);
+            if (H <= 0) continue;
+
+            auto captured = std::make_unique<MosaicSlot>();
+            captured->slot = std::move(slot);
+            captured->width = W;
+            captured->height = H;
+            captured->matrix = matrix;
+            input.queue.Push(std::move(captured), SlotQueue<MosaicSlot>::Policy::DropOldest, active);
+            arrivals.Signal();
+        }
+        if (started) {
+            std::lock_guard<std::mutex> lk(input.streamMutex);
+            input.queue.Clear();
+            rx_stream.stop();
+        }
+    }
+    catch (const ApiException& e) {
+        DC_LOG("{}ApiException: {}", tag, e.what());
+    }
+    catch (const std::exception& e) {
+        DC_LOG("{}std::exception: {}", tag, e.what());
+    }
+}
 
 extern "C" {
 
@@ -842,6 +1531,7 @@ extern "C" {
     UNITYDLL_EXPORT const char* GetMessage() {
         static std::string last;
         std::lock_guard<std::mutex> lk(messageMutex);
+        LogRing::Instance().Drain(message);
         last = message;
         message.clear();
         return last.c_str(); // 'last' persists between calls
@@ -869,6 +1559,281 @@ extern "C" {
         return nativeFrameCounter[index].load(std::memory_order_relaxed);
     }
 
+    UNITYDLL_EXPORT int RunConversionBenchmark(int width, int height, int iterations, char* buffer, int bufferSize)
+    {
+        const std::string report = BenchmarkConversionPaths(width, height, iterations);
+        DC_LOG("{}", report);
+
+        if (buffer && bufferSize > 0) {
+            strncpy(buffer, report.c_str(), bufferSize - 1);
+            buffer[bufferSize - 1] = '\0';
+        }
+        return int(report.size());
+    }
+
+    UNITYDLL_EXPORT int RunDispatchBenchmark(int width, int height, int iterations, char* buffer, int bufferSize)
+    {
+        const std::string report = BenchmarkConversionDispatch(width, height, iterations);
+        DC_LOG("{}", report);
+
+        if (buffer && bufferSize > 0) {
+            strncpy(buffer, report.c_str(), bufferSize - 1);
+            buffer[bufferSize - 1] = '\0';
+        }
+        return int(report.size());
+    }
+
+    UNITYDLL_EXPORT int RunColorMatrixBenchmark(int width, int height, int iterations, char* buffer, int bufferSize)
+    {
+        const std::string report = BenchmarkColorMatrices(width, height, iterations);
+        DC_LOG("{}", report);
+
+        if (buffer && bufferSize > 0) {
+            strncpy(buffer, report.c_str(), bufferSize - 1);
+            buffer[bufferSize - 1] = '\0';
+        }
+        return int(report.size());
+    }
+
+    UNITYDLL_EXPORT int RunFieldBobBenchmark(int width, int height, int iterations, char* buffer, int bufferSize)
+    {
+        const std::string report = BenchmarkFieldBob(width, height, iterations);
+        DC_LOG("{}", report);
+
+        if (buffer && bufferSize > 0) {
+            strncpy(buffer, report.c_str(), bufferSize - 1);
+            buffer[bufferSize - 1] = '\0';
+        }
+        return int(report.size());
+    }
+
+    UNITYDLL_EXPORT int RunSignalMonitorBenchmark(int frames, int probeCostUs, int pollIntervalMs,
+                                                  char* buffer, int bufferSize)
+    {
+        const std::string report = BenchmarkSignalPolling(frames, probeCostUs, pollIntervalMs);
+        DC_LOG("{}", report);
+
+        if (buffer && bufferSize > 0) {
+            strncpy(buffer, report.c_str(), bufferSize - 1);
+            buffer[bufferSize - 1] = '\0';
+        }
+        return int(report.size());
+    }
+
+    UNITYDLL_EXPORT int RunLoggingBenchmark(int iterations, char* buffer, int bufferSize)
+    {
+        const std::string report = BenchmarkLogging(iterations);
+        DC_LOG("{}", report);
+
+        if (buffer && bufferSize > 0) {
+            strncpy(buffer, report.c_str(), bufferSize - 1);
+            buffer[bufferSize - 1] = '\0';
+        }
+        return int(report.size());
+    }
+
+    UNITYDLL_EXPORT void SetTracing(int enabled)
+    {
+        Tracer::Instance().SetEnabled(enabled != 0);
+        DC_LOG("tracing {}", enabled ? "on" : "off");
+    }
+
+    UNITYDLL_EXPORT int DumpTrace(const char* path)
+    {
+        if (!path || !*path) return -1;
+        const int events = Tracer::Instance().Dump(path);
+        if (events < 0) DC_LOG_WARN("trace: cannot write {}", path);
+        else DC_LOG("trace: {} events written to {}", events, path);
+        return events;
+    }
+
+    UNITYDLL_EXPORT void SetSignalPollInterval(int intervalMs)
+    {
+        signalPollIntervalMs.store(intervalMs > 0 ? intervalMs : 100);
+    }
+
+    UNITYDLL_EXPORT void SetConversionThreads(int threads)
+    {
+        ConversionPool::Instance().SetThreadCount(threads);
+        DC_LOG("conversion threads={}", ConversionPool::Instance().ThreadCount());
+    }
+
+    UNITYDLL_EXPORT int GetConversionThreads()
+    {
+        return ConversionPool::Instance().ThreadCount();
+    }
+
+    UNITYDLL_EXPORT void GetConversionTiming(int index, double* wallMs, double* serialMs)
+    {
+        if (index < 0 || index >= 4) return;
+
+        if (wallMs) *wallMs = conversionStats[index].wallMs.load(std::memory_order_relaxed);
+        if (serialMs) *serialMs = conversionStats[index].serialMs.load(std::memory_order_relaxed);
+    }
+
+    UNITYDLL_EXPORT void SetOutputFormat(int index, unsigned int format)
+    {
+        if (index < 0 || index >= 4) return;
+        if (format != UNITYDELTACAST_OUTPUT_RGBA16 && format != UNITYDELTACAST_OUTPUT_UYVY8) {
+            format = UNITYDELTACAST_OUTPUT_BGRA8;
+        }
+        outputFormat[index].store(format);
+    }
+
+    UNITYDLL_EXPORT void SetColorMatrix(int index, unsigned int matrix)
+    {
+        if (index < 0 || index >= 4) return;
+        if (matrix > unsigned(ColorMatrix::Count)) matrix = UNITYDELTACAST_COLOR_MATRIX_AUTO;
+        colorMatrixSetting[index].store(matrix);
+    }
+
+    UNITYDLL_EXPORT unsigned int GetColorMatrix(int index)
+    {
+        if (index < 0 || index >= 4) return UNITYDELTACAST_COLOR_MATRIX_AUTO;
+        return activeColorMatrix[index].load(std::memory_order_relaxed);
+    }
+
+    UNITYDLL_EXPORT int GetFrameFormat(int index, unsigned int* format, int* pitch, int* w, int* h)
+    {
+        if (index < 0 || index >= 4) return 0;
+        ConvertPendingFrame(index);
+
+        FrameRing::Frame* frame = frameRings[index].Acquire();
+        if (!frame) return 0;
+
+        if (format) *format = frame->format;
+        if (pitch) *pitch = frame->pitch;
+        if (w) *w = frame->width;
+        if (h) *h = frame->height;
+        frameRings[index].Release(frame);
+        return 1;
+    }
+
+    UNITYDLL_EXPORT void SetSlotQueuePolicy(int index, unsigned int policy, int capacity)
+    {
+        if (index < 0 || index >= 4) return;
+        if (policy != UNITYDELTACAST_SLOT_QUEUE_BLOCK) policy = UNITYDELTACAST_SLOT_QUEUE_DROP_OLDEST;
+        slotQueuePolicy[index].store(policy);
+        slotQueueCapacity[index].store(capacity > 0 ? std::min(capacity, 64) : 2);
+    }
+
+    UNITYDLL_EXPORT void SetConversionMode(int index, unsigned int mode)
+    {
+        if (index < 0 || index >= 4) return;
+        if (mode != UNITYDELTACAST_CONVERSION_ON_DEMAND) mode = UNITYDELTACAST_CONVERSION_EAGER;
+        conversionMode[index].store(mode);
+    }
+
+    UNITYDLL_EXPORT void GetOnDemandCounters(int index, unsigned long long* converted, unsigned long long* skipped)
+    {
+        if (converted) *converted = 0;
+        if (skipped) *skipped = 0;
+        if (index < 0 || index >= 4) return;
+
+        if (converted) *converted = pendingFrames[index].converted.load(std::memory_order_relaxed);
+        if (skipped) *skipped = pendingFrames[index].skipped.load(std::memory_order_relaxed);
+    }
+
+    UNITYDLL_EXPORT void SetLatencyMode(int index, unsigned int mode)
+    {
+        if (index < 0 || index >= 4) return;
+        if (mode != UNITYDELTACAST_LATENCY_NEWEST) mode = UNITYDELTACAST_LATENCY_QUEUED;
+        latencyMode[index].store(mode);
+    }
+
+    UNITYDLL_EXPORT void GetFrameAge(int index, double* lastMs, double* averageMs, unsigned long long* drainedSlots)
+    {
+        if (lastMs) *lastMs = 0.0;
+        if (averageMs) *averageMs = 0.0;
+        if (drainedSlots) *drainedSlots = 0;
+        if (index < 0 || index >= 4) return;
+
+        if (lastMs) *lastMs = frameAges[index].lastMs.load(std::memory_order_relaxed);
+        if (averageMs) *averageMs = frameAges[index].averageMs.load(std::memory_order_relaxed);
+        if (drainedSlots) *drainedSlots = frameAges[index].drained.load(std::memory_order_relaxed);
+    }
+
+    UNITYDLL_EXPORT int GetFrameTiming(int index, unsigned long long seq, double* popMs, double* convertMs,
+                                       double* publishMs, double* fetchMs)
+    {
+        if (popMs) *popMs = -1.0;
+        if (convertMs) *convertMs = -1.0;
+        if (publishMs) *publishMs = -1.0;
+        if (fetchMs) *fetchMs = -1.0;
+        if (index < 0 || index >= 4) return 0;
+
+        FrameTimingLog::Stamps st;
+        if (!frameTimings[index].Lookup(seq, st)) return 0;
+        const int64_t captured = st.ns[FrameTimingLog::Captured];
+        auto sinceCapture = [&](FrameTimingLog::Stage stage) {
+            return st.ns[stage] == 0 ? -1.0 : double(st.ns[stage] - captured) / 1e6;
+        };
+        if (popMs) *popMs = sinceCapture(FrameTimingLog::Popped);
+        if (convertMs) *convertMs = sinceCapture(FrameTimingLog::Converted);
+        if (publishMs) *publishMs = sinceCapture(FrameTimingLog::Published);
+        if (fetchMs) *fetchMs = sinceCapture(FrameTimingLog::Fetched);
+        return 1;
+    }
+
+    UNITYDLL_EXPORT int GetLatencyStats(int index, double* publishP50, double* publishP99,
+                                        double* fetchP50, double* fetchP99)
+    {
+        double p50 = 0.0, p99 = 0.0;
+        if (index < 0 || index >= 4) {
+            if (publishP50) *publishP50 = 0.0;
+            if (publishP99) *publishP99 = 0.0;
+            if (fetchP50) *fetchP50 = 0.0;
+            if (fetchP99) *fetchP99 = 0.0;
+            return 0;
+        }
+
+        const int frames = frameTimings[index].Percentiles(FrameTimingLog::Captured, FrameTimingLog::Published, p50, p99);
+        if (publishP50) *publishP50 = p50;
+        if (publishP99) *publishP99 = p99;
+        frameTimings[index].Percentiles(FrameTimingLog::Captured, FrameTimingLog::Fetched, p50, p99);
+        if (fetchP50) *fetchP50 = p50;
+        if (fetchP99) *fetchP99 = p99;
+        return frames;
+    }
+
+    UNITYDLL_EXPORT int GetStreamStats(int index, StreamStats* stats)
+    {
+        if (!stats) return 0;
+        *stats = StreamStats();
+        if (index < 0 || index >= 4) return 0;
+
+        const StreamCounters& c = streamCounters[index];
+        stats->capturedFrames = c.captured.load(std::memory_order_relaxed);
+        stats->publishedFrames = c.published.load(std::memory_order_relaxed);
+        stats->consumedFrames = c.consumed.load(std::memory_order_relaxed);
+        stats->boardSlotsCount = c.boardSlots.load(std::memory_order_relaxed);
+        stats->boardSlotsDropped = boardSlotsDropped[index].load(std::memory_order_relaxed);
+        stats->conversionP50Ms = c.conversion.Percentile(0.50);
+        stats->conversionP99Ms = c.conversion.Percentile(0.99);
+        stats->conversionMaxMs = c.conversion.MaxMs();
+        stats->publishToFetchMs = c.publishToFetchMs.load(std::memory_order_relaxed);
+        const RecorderCtx& r = recorders[index];
+        stats->recorderBacklog = r.recording.load(std::memory_order_relaxed) ? r.backlog.load(std::memory_order_relaxed) : 0;
+        stats->recorderGapFills = r.gapFills.load(std::memory_order_relaxed);
+        stats->captureThreadCpuMs = c.captureCpuMs.load(std::memory_order_relaxed);
+        stats->conversionThreadCpuMs = c.conversionCpuMs.load(std::memory_order_relaxed);
+        return 1;
+    }
+
+    UNITYDLL_EXPORT void GetSlotQueueCounters(int index, int* occupancy, int* capacity,
+                                              unsigned long long* queueDropped,
+                                              unsigned long long* boardDropped,
+                                              unsigned long long* publishDropped)
+    {
+        if (index < 0 || index >= 4) return;
+
+        if (occupancy) *occupancy = slotQueues[index].Occupancy();
+        if (capacity) *capacity = slotQueues[index].Capacity();
+        if (queueDropped) *queueDropped = slotQueues[index].Drops();
+        if (boardDropped) *boardDropped = boardSlotsDropped[index].load(std::memory_order_relaxed);
+        if (publishDropped) *publishDropped = frameRings[index].Dropped();
+    }
+
     UNITYDLL_EXPORT void GetSignalAndVideoInfo(int index, char* buffer, int bufferSize) {
         if (index < 0 || index >= 4 || !buffer || bufferSize <= 0)
             return;
@@ -885,36 +1850,22 @@ extern "C" {
                                        int fps,
                                        int segmentSeconds,
                                        const char* encoderArgs,
-                                       int applyVFlip)
+                                       int applyVFlip,
+                                       unsigned int pixelFormat)
     {
         if (index < 0 || index >= 4) return 0;
         if (!outputPattern || !*outputPattern) return 0;
-        if (fps <= 0) fps = 30;
-        if (segmentSeconds <= 0) segmentSeconds = 60;
 
-        RecorderCtx& r = recorders[index];
-
-        bool expected = false;
-        if (!r.recording.compare_exchange_strong(expected, true)) {
-            return 0; // already recording
-        }
+        return StartRecorder(index, (ffmpegExe && *ffmpegExe) ? ffmpegExe : "ffmpeg", outputPattern, fps,
+                             segmentSeconds, encoderArgs ? encoderArgs : "", applyVFlip != 0, pixelFormat, "");
+    }
 
-        // A previous session may have stopped on its own (e.g. resolution change) without
-        // StopRecording() being called yet; join its finished thread before reusing the slot.
-        if (r.thread.joinable()) r.thread.join();
+    UNITYDLL_EXPORT int StartRecordingPipe(int index, const char* commandLine, int fps, unsigned int pixelFormat)
+    {
+        if (index < 0 || index >= 4) return 0;
+        if (!commandLine || !*commandLine) return 0;
 
-        r.recordedFrame.store(0, std::memory_order_relaxed);
-        r.ffmpegExe = (ffmpegExe && *ffmpegExe) ? ffmpegExe : "ffmpeg";
-        r.outputPattern = outputPattern;
-        r.encoderArgs = encoderArgs ? encoderArgs : "";
-        r.fps = fps;
-        r.segmentSeconds = segmentSeconds;
-        r.vflip = (applyVFlip != 0);
-        r.width = 0;
-        r.height = 0;
-
-        r.thread = std::thread(RecordWriterLoop, index);
-        return 1;
+        return StartRecorder(index, "", "", fps, 0, "", false, pixelFormat, commandLine);
     }
 
     UNITYDLL_EXPORT void StopRecording(int index)
@@ -964,12 +1915,30 @@ UNITYDLL_EXPORT void StartCapture(
     if (!running[index].compare_exchange_strong(expected, true)) return; // already running
 
     nativeFrameCounter[index].store(0, std::memory_order_relaxed);
+    frameRings[index].Reset();
+    frameTimings[index].Reset();
+    ResetStreamCounters(index);
+    // The NEWEST latency mode keeps no more than the slot being converted waiting.
+    const bool drainToNewest = latencyMode[index].load() == UNITYDELTACAST_LATENCY_NEWEST;
+    slotQueues[index].Reset(drainToNewest ? 1 : slotQueueCapacity[index].load());
+    boardSlotsDropped[index].store(0, std::memory_order_relaxed);
+    frameAges[index].lastMs.store(0.0, std::memory_order_relaxed);
+    frameAges[index].averageMs.store(0.0, std::memory_order_relaxed);
+    frameAges[index].drained.store(0, std::memory_order_relaxed);
+    {
+        PendingFrame& pending = pendingFrames[index];
+        std::lock_guard<std::mutex> lk(pending.mutex);
+        pending.lastConverted = 0;
+        pending.converted.store(0, std::memory_order_relaxed);
+        pending.skipped.store(0, std::memory_order_relaxed);
+    }
 
     if (buffer_depth <= 0) {
         buffer_depth = 8;
     }
 
-        captureThread[index] = std::thread([index, device_id, rx_stream_id, buffer_depth, inputType, requested_width, requested_height, progressive, framerate, cable_color_space, cable_sampling, video_standard, clock_divisor, video_interface, fieldMerge, buffer_packing]() {
+        captureThread[index] = std::thread([index, device_id, rx_stream_id, buffer_depth, inputType, requested_width, requested_height, progressive, framerate, cable_color_space, cable_sampling, video_standard, clock_divisor, video_interface, fieldMerge, buffer_packing, drainToNewest]() {
+            Tracer::NameThread("capture " + std::to_string(index));
             bool started = false;
             try {
                 auto board = Board::open(device_id, nullptr);
@@ -1007,28 +1976,34 @@ UNITYDLL_EXPORT void StartCapture(
                 SetVideoInfo(index, Application::Helper::get_information_string(signal_information, "[Video] "));
 
                 // 3) Queue depth & packing
+                CaptureLayout layout = SelectCaptureLayout(signal_information, buffer_packing);
                 rx_stream.buffer_queue().set_depth(buffer_depth);
-                rx_stream.set_buffer_packing(buffer_packing);
-
-                // Preserve the existing merged-frame behavior for fieldMerge != 0.
-                // For an interlaced Level-B dual stream, fieldMerge == 0 selects
-                // field mode and publishes one bob-deinterlaced frame per field.
-                DC_LOG("fieldMerge=" + std::to_string(fieldMerge));
-                if (fieldMerge != 0) {
+                rx_stream.set_buffer_packing(layout.bufferPacking);
+                LogCaptureLayout(layout, buffer_packing);
+                ColorMatrix detectedMatrix = DetectColorMatrix(signal_information);
+                DC_LOG("signal color matrix={}", ColorMatrixName(detectedMatrix));
+
+                // Preserve the existing merged-frame behavior for fieldMerge == 1
+                // (and any other value outside the field modes). For an interlaced
+                // Level-B dual stream, fieldMerge == 0 / 2 selects field mode and
+                // publishes one bob / motion-adaptive deinterlaced frame per field.
+                DC_LOG("fieldMerge={}", fieldMerge);
+                const bool motionAdaptive = (fieldMerge == UNITYDELTACAST_FIELD_MODE_MOTION_ADAPTIVE);
+                if (fieldMerge != UNITYDELTACAST_FIELD_MODE_BOB && !motionAdaptive) {
                     rx_stream.enable_field_merge();
                 }
 
-                bool useFieldModeBob = ShouldUseFieldModeBob(signal_information, fieldMerge);
+                bool useFieldMode = ShouldUseFieldMode(signal_information, fieldMerge);
 
                 // 4) Configure stream to match the detected signal
                 Application::Helper::configure_stream(rx_tech_stream, signal_information);
 
-                if (useFieldModeBob) {
+                if (useFieldMode) {
                     if (!board.supports_field_mode()) {
                         throw std::runtime_error("The selected DELTACAST board does not support field mode");
                     }
                     rx_stream.enable_field_mode();
-                    DC_LOG("field mode bob enabled");
+                    DC_LOG("field mode {} enabled", motionAdaptive ? "motion-adaptive" : "bob");
                 }
 
 
@@ -1038,22 +2013,39 @@ UNITYDLL_EXPORT void StartCapture(
 
                 started = true;
 
-                bgra[index].resize(size_t(width[index]) * height[index] * 4);
-
-                DC_LOG("width=" + std::to_string(width[index]));
-                DC_LOG("height=" + std::to_string(height[index]));
-
+                DC_LOG("width={}", width[index].load());
+                DC_LOG("height={}", height[index].load());
+
+                // Declared after the stream so they are torn down first, even on exceptions.
+                const auto probe = MakeSignalProbe(board, rx_stream_id, rx_tech_stream);
+                const std::chrono::milliseconds pollInterval(signalPollIntervalMs.load());
+                SignalMonitor<SignalInformation> monitor;
+                monitor.Start(probe, signal_information, pollInterval);
+                deinterlacers[index].Reset();
+                ConversionStage conversion(index);
+                const auto queuePolicy = slotQueuePolicy[index].load() == UNITYDELTACAST_SLOT_QUEUE_BLOCK && !drainToNewest
+                    ? SlotQueue<CapturedSlot>::Policy::Block
+                    : SlotQueue<CapturedSlot>::Policy::DropOldest;
+                if (drainToNewest) DC_LOG("latency mode: drain to newest slot");
+
+                SignalInformation cur;
                 while (running[index].load()) {
-                    if (!Application::Helper::wait_for_input(board.rx(rx_stream_id), running[index])) {
+                    // Signal presence and format are polled by the monitor, not per frame.
+                    if (!monitor.SignalPresent()) {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(10));
                         continue;
                     }
                     // If signal changes mid-run, reconfigure
-                    auto cur = Application::Helper::detect_information(rx_tech_stream);
-                    if (cur != signal_information) {
+                    if (monitor.Changed(cur)) {
+                        // No probing while the stream is reconfigured: reads could
+                        // fail or describe a half-configured stream.
+                        monitor.Stop();
                         if (started) { 
+                            conversion.Pause();
                             rx_stream.stop();
                             started = false; 
                         }
+                        deinterlacers[index].Reset();
                         signal_information = cur;
                         SetVideoInfo(index, Application::Helper::get_information_string(signal_information, "[Video] "));
                         vc = Application::Helper::get_video_characteristics(signal_information);
@@ -1061,97 +2053,107 @@ UNITYDLL_EXPORT void StartCapture(
                         H = vc.height;
                         width[index].store(W);
                         height[index].store(H);
-                        bgra[index].resize(size_t(W) * H * 4);
+                        detectedMatrix = DetectColorMatrix(signal_information);
+                        DC_LOG("signal color matrix={}", ColorMatrixName(detectedMatrix));
 
+                        layout = SelectCaptureLayout(signal_information, buffer_packing);
                         rx_stream.buffer_queue().set_depth(buffer_depth);
-                        rx_stream.set_buffer_packing(buffer_packing);
+                        rx_stream.set_buffer_packing(layout.bufferPacking);
+                        LogCaptureLayout(layout, buffer_packing);
 
-                        const bool newUseFieldModeBob = ShouldUseFieldModeBob(signal_information, fieldMerge);
-                        if (useFieldModeBob && !newUseFieldModeBob) {
+                        const bool newUseFieldMode = ShouldUseFieldMode(signal_information, fieldMerge);
+                        if (useFieldMode && !newUseFieldMode) {
                             rx_stream.disable_field_mode();
                         }
 
                         Application::Helper::configure_stream(rx_tech_stream, signal_information);
 
-                        if (!useFieldModeBob && newUseFieldModeBob) {
+                        if (!useFieldMode && newUseFieldMode) {
                             if (!board.supports_field_mode()) {
                                 throw std::runtime_error("The selected DELTACAST board does not support field mode");
                             }
                             rx_stream.enable_field_mode();
                         }
-                        useFieldModeBob = newUseFieldModeBob;
+                        useFieldMode = newUseFieldMode;
 
                         rx_stream.start();
                         started = true;
+                        monitor.Start(probe, signal_information, pollInterval);
+                        conversion.Resume();
                         continue;
                     }
-                    auto slot = rx_stream.pop_slot();
-                    auto [src, totalBytes] = slot->video().buffer();
-                    if (height[index] <= 0) {
-                        continue;
-                    }
-                    int dstPitch = width[index] * 4;
-
-                    if (useFieldModeBob) {
-                        const bool evenField = (slot->parity() == Slot::Parity::EVEN);
-                        if (!UYVY_Field_to_BGRA_Bob(
-                                src,
-                                totalBytes,
-                                bgra[index].data(),
-                                dstPitch,
-                                width[index],
-                                height[index],
-                                evenField,
-                                true)) {
-                            DC_LOG("field mode bob: unexpected field buffer size="
-                                + std::to_string(totalBytes));
-                            continue;
+
+                    std::unique_ptr<Slot> slot;
+                    unsigned int backlog = 0;
+                    bool drained = false;
+                    try {
+                        TraceScope scope("pop_slot");
+                        slot = rx_stream.pop_slot();
+                        backlog = rx_stream.buffer_queue().slots_count();
+                        // NEWEST: keep popping while the board holds filled slots; each
+                        // replaced slot goes straight back to the board unconverted.
+                        for (; drainToNewest && backlog > 0; backlog = rx_stream.buffer_queue().slots_count()) {
+                            slot = rx_stream.pop_slot();
+                            frameAges[index].drained.fetch_add(1, std::memory_order_relaxed);
+                            streamCounters[index].captured.fetch_add(1, std::memory_order_relaxed);
+                            drained = true;
                         }
                     }
-                    else {
-                        // Derive source pitch for the legacy full-frame path.
-                        int srcPitch = int(totalBytes / height[index]);
-                        UYVY_to_BGRA(src, srcPitch, bgra[index].data(), dstPitch,
-                            width[index], height[index], true);
-                    }
-
-                    const unsigned long long frameNo =
-                        nativeFrameCounter[index].load(std::memory_order_relaxed) + 1;
-
-                    if (burnInFrameNumber[index].load(std::memory_order_relaxed)) {
-                        BurnFrameNumberBGRA(
-                            bgra[index].data(),
-                            width[index],
-                            height[index],
-                            dstPitch,
-                            frameNo,
-                            0,
-                            width[index],
-                            true
-                        );
+                    catch (const ApiException&) {
+                        // The signal can vanish between two monitor polls; wait for it again.
+                        if (board.rx(rx_stream_id).signal_present()) throw;
+                        continue;
                     }
-                    {
-                        std::lock_guard<std::mutex> lock(frameMutex[index]);
-                        latestFrame[index] = bgra[index];  // hand BGRA to Unity
+                    // The wrapper's slots carry no hardware timestamp: each slot still
+                    // queued behind this one arrived one slot period after it.
+                    const auto poppedAt = std::chrono::steady_clock::now();
+                    const auto capturedAt = poppedAt - backlog * SlotPeriod(vc.framerate, useFieldMode);
+                    boardSlotsDropped[index].store(rx_stream.buffer_queue().slots_dropped(), std::memory_order_relaxed);
+                    StreamCounters& counters = streamCounters[index];
+                    counters.captured.fetch_add(1, std::memory_order_relaxed);
+                    counters.boardSlots.store(backlog, std::memory_order_relaxed);
+                    counters.captureCpuMs.store(ThreadCpuMs(), std::memory_order_relaxed);
+                    if (H <= 0) {
+                        continue;
                     }
 
-                    // Publish the counter only after latestFrame is complete. The recorder's
-                    // acquire load then cannot associate a new counter with the old pixels.
-                    nativeFrameCounter[index].store(frameNo, std::memory_order_release);
+                    auto captured = std::make_unique<CapturedSlot>();
+                    captured->slot = std::move(slot);
+                    captured->width = W;
+                    captured->height = H;
+                    captured->fieldMode = useFieldMode;
+                    captured->motionAdaptive = motionAdaptive;
+                    captured->packing = layout.packing;
+                    captured->matrix = StreamColorMatrix(index, detectedMatrix);
+                    captured->rgb = layout.rgb;
+                    captured->rgbPacking = layout.rgbPacking;
+                    captured->rgbLimitedRange = layout.rgbLimitedRange;
+                    captured->afterDrain = drained;
+                    captured->capturedAt = capturedAt;
+                    captured->poppedAt = poppedAt;
+                    const unsigned int requestedFormat = outputFormat[index].load(std::memory_order_relaxed);
+                    // RGB captures are published as BGRA8 only: they have no more than 8 bits to keep.
+                    captured->format = requestedFormat == UNITYDELTACAST_OUTPUT_RGBA16 && !layout.rgb
+                        ? OutputFormat::RGBA16 : OutputFormat::BGRA8;
+                    // Raw publishing only exists for 8-bit UYVY; other packings are converted to BGRA8.
+                    captured->raw = requestedFormat == UNITYDELTACAST_OUTPUT_UYVY8 && !layout.rgb
+                        && layout.packing == SourcePacking::UYVY8;
+                    slotQueues[index].Push(std::move(captured), queuePolicy, running[index]);
 
                     //log("running");
                 }
                 if (started) {
+                    conversion.Pause();
                     rx_stream.stop();
                     started = false;
                 }
                 DC_LOG("finished");
             }
             catch (const ApiException& e) {
-                DC_LOG(std::string("ApiException: ") + e.what());
+                DC_LOG("ApiException: {}", e.what());
             }
             catch (const std::exception& e) {
-                DC_LOG(std::string("std::exception: ") + e.what());
+                DC_LOG("std::exception: {}", e.what());
             }
             });
     }
@@ -1289,38 +2291,42 @@ UNITYDLL_EXPORT void StartCaptureStereo(int device_id, int rx_stream_id, int buf
     if (!running[0].compare_exchange_strong(expected, true)) return; // already running
 
     nativeFrameCounter[0].store(0, std::memory_order_relaxed);
+    frameRings[0].Reset();
+    frameTimings[0].Reset();
+    ResetStreamCounters(0);
 
     if (buffer_depth <= 0) {
         buffer_depth = 8;
     }
 
         captureThread[0] = std::thread([device_id, rx_stream_id, buffer_depth]() {
+            Tracer::NameThread("stereo");
             bool started = false;
             try {
                 auto board = Board::open(device_id, nullptr);
-                DC_LOG("0");
+                DC_LOG_DEBUG("0");
                 // open RX tech stream and get base stream
                 auto rx_tech_stream = Application::Helper::open_stream(board, Application::Helper::rx_index_to_streamtype(rx_stream_id));
                 auto rx_tech_stream2 = Application::Helper::open_stream(board, Application::Helper::rx_index_to_streamtype(1));
                 auto& rx_stream = Application::Helper::to_base_stream(rx_tech_stream);
                 auto& rx_stream2 = Application::Helper::to_base_stream(rx_tech_stream2);
-                DC_LOG("1");
+                DC_LOG_DEBUG("1");
                 // 1) Wait until a signal is present on the connector
                 if (!Application::Helper::wait_for_input(board.rx(rx_stream_id), running[0])) {
                     throw std::runtime_error("No input detected on the requested RX");
                 }
-                DC_LOG("2");
+                DC_LOG_DEBUG("2");
                 // 2) Detect signal information (format, framerate, etc.)
                 SignalInformation signal_information;// = Application::Helper::detect_information(rx_tech_stream);
                 SignalInformation signal_information2;// = Application::Helper::detect_information(rx_tech_stream2);
-                DC_LOG("2.1");
+                DC_LOG_DEBUG("2.1");
                 signal_information = SdiSignalInformation{ VHD_VIDEOSTD_S274M_1080i_50Hz, VHD_CLOCKDIV_1, VHD_INTERFACE_3G_B_DS_425_1 };
                 signal_information2 = SdiSignalInformation{ VHD_VIDEOSTD_S274M_1080i_50Hz, VHD_CLOCKDIV_1, VHD_INTERFACE_3G_B_DS_425_1 };
                 
-                DC_LOG("2.2");
+                DC_LOG_DEBUG("2.2");
                 auto vc = Application::Helper::get_video_characteristics(signal_information);
                 auto vc2 = Application::Helper::get_video_characteristics(signal_information2);
-                DC_LOG("2.3");
+                DC_LOG_DEBUG("2.3");
                 // after vc / vc2 have been computed:
                 int W = vc.width, H = vc.height;
                 int W2 = vc2.width, H2 = vc2.height;
@@ -1334,99 +2340,123 @@ UNITYDLL_EXPORT void StartCaptureStereo(int device_id, int rx_stream_id, int buf
                 // Make info of the signal available as a simple string (stereo publishes to index 0)
                 SetVideoInfo(0, Application::Helper::get_information_string(signal_information, "[Video] "));
 
-                // allocate working & output buffers
-                bgra[0].resize(size_t(W) * H * 4);
-                bgra[1].resize(size_t(W2) * H2 * 4);
-                sbsBGRA.resize(size_t(outW) * outH * 4);
-                DC_LOG("stereo: L=" + std::to_string(W) + "x" + std::to_string(H)
-                    + " R=" + std::to_string(W2) + "x" + std::to_string(H2)
-                    + " out=" + std::to_string(outW) + "x" + std::to_string(outH));
+                DC_LOG("stereo: L={}x{} R={}x{} out={}x{}", W, H, W2, H2, outW, outH);
 
-                DC_LOG("3");
+                DC_LOG_DEBUG("3");
                 // 3) Queue depth & packing
                 rx_stream.buffer_queue().set_depth(buffer_depth);
                 rx_stream2.buffer_queue().set_depth(buffer_depth);
                 rx_stream.set_buffer_packing(VHD_BUFPACK_VIDEO_YUV422_8);
                 rx_stream2.set_buffer_packing(VHD_BUFPACK_VIDEO_YUV422_8);
 
-                DC_LOG("?");
+                DC_LOG_DEBUG("?");
                 //????
                 rx_stream.enable_field_merge();
                 rx_stream2.enable_field_merge();
                 //rx_stream.set_low_latency_mode(VHD_LLM_DATA_BLOCK);
                 //rx_stream2.set_low_latency_mode(VHD_LLM_DATA_BLOCK);
 
-                DC_LOG("4");
+                DC_LOG_DEBUG("4");
                 // 4) Configure stream to match the detected signal
                 Application::Helper::configure_stream(rx_tech_stream, signal_information);
                 Application::Helper::configure_stream(rx_tech_stream2, signal_information2);
 
 
-                DC_LOG("5");
+                DC_LOG_DEBUG("5");
                 // 5) Start the stream
                 rx_stream.start();
                 rx_stream2.start();
 
                 started = true;
 
+                const auto probe = MakeSignalProbe(board, rx_stream_id, rx_tech_stream);
+                const std::chrono::milliseconds pollInterval(signalPollIntervalMs.load());
+                SignalMonitor<SignalInformation> monitor;
+                monitor.Start(probe, signal_information, pollInterval);
+
+                SignalInformation cur;
                 while (running[0].load()) {
-                    if (!Application::Helper::wait_for_input(board.rx(rx_stream_id), running[0])) {
+                    // Signal presence and format are polled by the monitor, not per frame.
+                    if (!monitor.SignalPresent()) {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(10));
                         continue;
                     }
-                    DC_LOG("6");
+                    DC_LOG_DEBUG("6");
                     // If signal changes mid-run, reconfigure
-                    auto cur = Application::Helper::detect_information(rx_tech_stream);
-                    if (cur != signal_information) {
+                    if (monitor.Changed(cur)) {
+                        // No probing while the stream is reconfigured.
+                        monitor.Stop();
                         if (started) {
                             rx_stream.stop();
                             started = false; 
                         }
-                        DC_LOG("6");
+                        DC_LOG_DEBUG("6");
                         signal_information = cur;
                         SetVideoInfo(0, Application::Helper::get_information_string(signal_information, "[Video] "));
                         vc = Application::Helper::get_video_characteristics(signal_information);
                         W = vc.width; H = vc.height;
-                        width[0].store(W);
-                        height[0].store(H);
-                        bgra[0].resize(size_t(W) * H * 4);
+                        outW = W + W2;
+                        outH = (H > H2) ? H : H2;
+                        width[0].store(outW);
+                        height[0].store(outH);
 
                         rx_stream.buffer_queue().set_depth(buffer_depth);
                         rx_stream.set_buffer_packing(VHD_BUFPACK_VIDEO_YUV422_8);
                         Application::Helper::configure_stream(rx_tech_stream, signal_information);
                         rx_stream.start();
                         started = true;
+                        monitor.Start(probe, signal_information, pollInterval);
                         continue;
                     }
-                    DC_LOG("8");
-                    auto slot = rx_stream.pop_slot();
-                    auto slot2 = rx_stream2.pop_slot();
+                    DC_LOG_DEBUG("8");
+                    std::unique_ptr<Slot> slot;
+                    std::unique_ptr<Slot> slot2;
+                    try {
+                        TraceScope popScope("pop_slot");
+                        slot = rx_stream.pop_slot();
+                        slot2 = rx_stream2.pop_slot();
+                    }
+                    catch (const ApiException&) {
+                        // The signal can vanish between two monitor polls; hand the
+                        // first eye's slot back and wait for it again.
+                        slot.reset();
+                        if (board.rx(rx_stream_id).signal_present()) throw;
+                        continue;
+                    }
+                    streamCounters[0].captured.fetch_add(1, std::memory_order_relaxed);
+                    streamCounters[0].boardSlots.store(rx_stream.buffer_queue().slots_count(), std::memory_order_relaxed);
+                    streamCounters[0].captureCpuMs.store(ThreadCpuMs(), std::memory_order_relaxed);
                     auto [src, totalBytes] = slot->video().buffer();
                     auto [src2, totalBytes2] = slot2->video().buffer();
 
-                    int srcPitch = (H > 0) ? int(totalBytes / H) : 0;
-                    int srcPitch2 = (H2 > 0) ? int(totalBytes2 / H2) : 0;
-
-                    int dstPitch = W * 4;
-                    int dstPitch2 = W2 * 4;
-                    DC_LOG("9");
-                    UYVY_to_BGRA(src, srcPitch, bgra[0].data(), dstPitch, W, H, true);
-                    UYVY_to_BGRA(src2, srcPitch2, bgra[1].data(), dstPitch2, W2, H2, true);
-
-                    bool topFieldFirst = (slot->parity() == Slot::Parity::EVEN);
-                    // pack into one wide texture
-                    PackSideBySide_BGRA_deinterlaced(bgra[0].data(), W, H, dstPitch,
-                        bgra[1].data(), W2, H2, dstPitch2,
-                        sbsBGRA.data(), outW, outH, topFieldFirst);
+                    const StereoEye eyes[2] = {
+                        { src, (H > 0) ? int(totalBytes / H) : 0, W, H },
+                        { src2, (H2 > 0) ? int(totalBytes2 / H2) : 0, W2, H2 },
+                    };
+                    DC_LOG_DEBUG("9");
+                    FrameRing::Frame* frame = frameRings[0].BeginWrite(outW, outH, outW * 4, UNITYDELTACAST_OUTPUT_BGRA8, size_t(outW) * outH * 4);
+                    if (!frame) {
+                        continue;
+                    }
 
                     const unsigned long long frameNo =
-                        nativeFrameCounter[0].fetch_add(1, std::memory_order_relaxed) + 1;
+                        nativeFrameCounter[0].load(std::memory_order_relaxed) + 1;
+
+                    // Both eyes in one pass, straight into the published side-by-side frame.
+                    const bool topFieldFirst = (slot->parity() == Slot::Parity::EVEN);
+                    const ColorMatrix matrix = StreamColorMatrix(0, DetectColorMatrix(signal_information));
+                    TraceScope convertScope("convert", frameNo);
+                    RecordConversionTiming(0, ConvertStereoSideBySide(eyes, frame->data.data(), outW, outH, topFieldFirst, matrix));
+                    convertScope.End();
+                    activeColorMatrix[0].store(unsigned(matrix) + 1, std::memory_order_relaxed);
 
                     if (burnInFrameNumber[0].load(std::memory_order_relaxed)) {
+                        TraceScope scope("burn_in", frameNo);
                         const int outPitch = outW * 4;
 
                         // Burn into upper-right corner of the left eye.
                         BurnFrameNumberBGRA(
-                            sbsBGRA.data(),
+                            frame->data.data(),
                             outW,
                             outH,
                             outPitch,
@@ -1438,7 +2468,7 @@ UNITYDLL_EXPORT void StartCaptureStereo(int device_id, int rx_stream_id, int buf
 
                         // Burn the same number into upper-right corner of the right eye.
                         BurnFrameNumberBGRA(
-                            sbsBGRA.data(),
+                            frame->data.data(),
                             outW,
                             outH,
                             outPitch,
@@ -1449,16 +2479,17 @@ UNITYDLL_EXPORT void StartCaptureStereo(int device_id, int rx_stream_id, int buf
                         );
                     }
                     // publish the single combined frame
-                    {
-                        std::lock_guard<std::mutex> lock(frameMutex[0]);
-                        latestFrame[0] = sbsBGRA;
-                    }
+                    TraceScope publishScope("publish", frameNo);
+                    frameRings[0].Publish(frame, frameNo);
+                    streamCounters[0].published.fetch_add(1, std::memory_order_relaxed);
+                    nativeFrameCounter[0].store(frameNo, std::memory_order_release);
+                    publishScope.End();
 
 
                     //log("running");
-                    DC_LOG("10");
+                    DC_LOG_DEBUG("10");
                 }
-                DC_LOG("11");
+                DC_LOG_DEBUG("11");
                 if (started) {
                     rx_stream.stop();
                     rx_stream2.stop();
@@ -1467,15 +2498,127 @@ UNITYDLL_EXPORT void StartCaptureStereo(int device_id, int rx_stream_id, int buf
                 DC_LOG("finished");
             }
             catch (const ApiException& e) {
-                DC_LOG(std::string("ApiException: ") + e.what());
+                DC_LOG("ApiException: {}", e.what());
             }
             catch (const std::exception& e) {
-                DC_LOG(std::string("std::exception: ") + e.what());
+                DC_LOG("std::exception: {}", e.what());
             }
             });
     }
 
 
+UNITYDLL_EXPORT void StartCaptureMosaic(int index, const int* deviceIds, const int* rxStreamIds, int inputCount,
+                                        unsigned int layout, int tileWidth, int tileHeight, int buffer_depth)
+{
+    if (index < 0 || index >= 4 || !deviceIds || !rxStreamIds) return;
+
+    int rows = 0;
+    int columns = 0;
+    if (!GetMosaicGrid(layout, rows, columns)) {
+        DC_LOG("mosaic: unknown layout {}", layout);
+        return;
+    }
+    const int count = std::min(inputCount, rows * columns);
+    if (count <= 0) return;
+    if (tileWidth <= 0 || tileHeight <= 0) {
+        tileWidth = 1920 / columns;
+        tileHeight = 1080 / rows;
+    }
+    tileWidth &= ~1;
+    if (tileWidth <= 0) return;
+    if (buffer_depth <= 0) {
+        buffer_depth = 8;
+    }
+
+    bool expected = false;
+    if (!running[index].compare_exchange_strong(expected, true)) return; // already running
+
+    nativeFrameCounter[index].store(0, std::memory_order_relaxed);
+    frameRings[index].Reset();
+    frameTimings[index].Reset();
+    ResetStreamCounters(index);
+
+    std::vector<std::pair<int, int>> sources;
+    for (int i = 0; i < count; ++i) sources.emplace_back(deviceIds[i], rxStreamIds[i]);
+
+    captureThread[index] = std::thread([index, sources, rows, columns, tileWidth, tileHeight, buffer_depth]() {
+        Tracer::NameThread("mosaic " + std::to_string(index));
+        const int count = int(sources.size());
+        const int outW = columns * tileWidth;
+        const int outH = rows * tileHeight;
+        width[index].store(outW);
+        height[index].store(outH);
+        SetVideoInfo(index, "[Mosaic] " + std::to_string(rows) + "x" + std::to_string(columns)
+            + " tiles of " + std::to_string(tileWidth) + "x" + std::to_string(tileHeight)
+            + ", " + std::to_string(count) + " inputs, " + std::to_string(outW) + "x" + std::to_string(outH));
+
+        std::unique_ptr<MosaicInput[]> inputs(new MosaicInput[count]);
+        MosaicArrivals arrivals;
+        std::atomic<bool> inputsActive{ true };
+        for (int i = 0; i < count; ++i) {
+            inputs[i].deviceId = sources[i].first;
+            inputs[i].rxStreamId = sources[i].second;
+            inputs[i].thread = std::thread([index, i, &inputs, &arrivals, &inputsActive, buffer_depth] {
+                MosaicInputLoop(index, i, inputs[i], arrivals, inputsActive, buffer_depth);
+            });
+        }
+
+        std::vector<MosaicTile> tiles(count);
+        std::vector<std::unique_ptr<MosaicSlot>> fresh(count);
+        unsigned long long seen = 0;
+        while (running[index].load()) {
+            // Woken by whichever input delivers first; no input is locked while
+            // waiting, so each can stop and reconfigure its stream meanwhile.
+            arrivals.Wait(seen, std::chrono::milliseconds(40));
+
+            // Inputs with a new slot stay locked until the slot went back to the board.
+            std::vector<std::unique_lock<std::mutex>> held;
+            for (int i = 0; i < count; ++i) {
+                std::unique_lock<std::mutex> lk(inputs[i].streamMutex);
+                fresh[i] = inputs[i].queue.TryPop();
+                tiles[i] = MosaicTile();
+                if (!fresh[i]) continue;
+
+                auto [src, totalBytes] = fresh[i]->slot->video().buffer();
+                tiles[i].src = src;
+                tiles[i].srcPitch = int(totalBytes / fresh[i]->height);
+                tiles[i].srcWidth = fresh[i]->width;
+                tiles[i].srcHeight = fresh[i]->height;
+                tiles[i].matrix = StreamColorMatrix(index, fresh[i]->matrix);
+                held.push_back(std::move(lk));
+            }
+            if (held.empty()) continue;
+
+            // Tiles without a new frame are copied from the last composed one.
+            FrameRing::Frame* previous = frameRings[index].Acquire();
+            FrameRing::Frame* frame = frameRings[index].BeginWrite(outW, outH, outW * 4, UNITYDELTACAST_OUTPUT_BGRA8, size_t(outW) * outH * 4);
+            if (frame) {
+                const unsigned long long frameNo =
+                    nativeFrameCounter[index].load(std::memory_order_relaxed) + 1;
+                if (tiles[0].src) activeColorMatrix[index].store(unsigned(tiles[0].matrix) + 1, std::memory_order_relaxed);
+                TraceScope composeScope("compose", frameNo);
+                RecordConversionTiming(index, ComposeMosaic(tiles.data(), count, columns, rows, tileWidth, tileHeight,
+                    frame->data.data(), outW * 4, previous ? previous->data.data() : nullptr));
+                composeScope.End();
+                TraceScope publishScope("publish", frameNo);
+                frameRings[index].Publish(frame, frameNo);
+                nativeFrameCounter[index].store(frameNo, std::memory_order_release);
+                streamCounters[index].published.fetch_add(1, std::memory_order_relaxed);
+            }
+            frameRings[index].Release(previous);
+
+            // Slots go back to the board before their inputs are unlocked.
+            for (auto& slot : fresh) slot.reset();
+        }
+
+        inputsActive.store(false);
+        for (int i = 0; i < count; ++i) {
+            if (inputs[i].thread.joinable()) inputs[i].thread.join();
+        }
+        DC_LOG("mosaic {} finished", index);
+    });
+}
+
     UNITYDLL_EXPORT void StopCapture(int index)
     {
         running[index].store(false);
@@ -1498,14 +2641,81 @@ UNITYDLL_EXPORT void StartCaptureStereo(int device_id, int rx_stream_id, int buf
 
     UNITYDLL_EXPORT int GetFrame(int index, uint8_t* dst, int maxSize)
     {
-        std::lock_guard<std::mutex> lk(frameMutex[index]);
-        int n = std::min<int>(maxSize, latestFrame[index].size());
+        if (index < 0 || index >= 4 || !dst) return 0;
+        TraceScope scope("GetFrame");
+        ConvertPendingFrame(index);
+
+        FrameRing::Frame* frame = frameRings[index].Acquire();
+        if (!frame) return 0;
+
+        scope.SetFrame(frame->seq.load(std::memory_order_relaxed));
+        int n = std::min<int>(maxSize, int(frame->data.size()));
         if (n > 0) {
-            std::memcpy(dst, latestFrame[index].data(), n);
+            std::memcpy(dst, frame->data.data(), n);
         }
+        CountConsumed(index, frame->seq.load(std::memory_order_relaxed));
+        frameRings[index].Release(frame);
         return n;
     }
 
+    UNITYDLL_EXPORT int GetFrameIfNewer(int index, uint8_t* dst, int maxSize,
+                                        unsigned long long lastSeen, unsigned long long* seqOut)
+    {
+        if (seqOut) *seqOut = lastSeen;
+        if (index < 0 || index >= 4 || !dst) return 0;
+
+        // Cheap early out: nothing was published since the caller's last copy.
+        if (nativeFrameCounter[index].load(std::memory_order_acquire) <= lastSeen) return 0;
+        TraceScope scope("GetFrameIfNewer");
+        ConvertPendingFrame(index);
+
+        FrameRing::Frame* frame = frameRings[index].Acquire();
+        if (!frame) return 0;
+
+        const unsigned long long seq = frame->seq.load(std::memory_order_relaxed);
+        scope.SetFrame(seq);
+        int n = 0;
+        if (seq > lastSeen) {
+            n = std::min<int>(maxSize, int(frame->data.size()));
+            if (n > 0) {
+                std::memcpy(dst, frame->data.data(), n);
+            }
+            if (seqOut) *seqOut = seq;
+            CountConsumed(index, seq);
+        }
+        frameRings[index].Release(frame);
+        return n;
+    }
+
+    UNITYDLL_EXPORT int AcquireFrame(int index, const uint8_t** data, int* size, unsigned long long* seq)
+    {
+        if (data) *data = nullptr;
+        if (size) *size = 0;
+        if (seq) *seq = 0;
+        if (index < 0 || index >= 4 || !data || !size || !seq) return 0;
+        TraceScope scope("AcquireFrame");
+        ConvertPendingFrame(index);
+
+        FrameRing::Frame* frame = frameRings[index].Lend();
+        if (!frame) return 0;
+
+        *data = frame->data.data();
+        *size = int(frame->data.size());
+        *seq = frame->seq.load(std::memory_order_relaxed);
+        scope.SetFrame(*seq);
+        CountConsumed(index, *seq);
+        return 1;
+    }
+
+    UNITYDLL_EXPORT void ReleaseFrame(int index, unsigned long long seq)
+    {
+        if (index < 0 || index >= 4) return;
+
+        if (!frameRings[index].ReturnLent(seq)) {
+            DC_LOG("ReleaseFrame: frame {} is not lent, index={}", seq, index);
+        }
+    }
+
     //UNITYDLL_EXPORT int GetFrame2(uint8_t* dst, int maxSize)
     //{
     //    std::lock_guard<std::mutex> lk(frameMutex2);
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <stdint.h>
+
 #ifdef _WIN32
 #  define UNITYDLL_EXPORT __declspec(dllexport)
 #else
@@ -10,9 +12,69 @@
 // For a 1080i50 SMPTE 425-1 Level-B dual-stream input, 0 selects SDK field
 // mode and expands every captured field to a full-height frame with bob
 // deinterlacing. For other input formats, 0 retains the previous unmerged frame
-// behavior.
-#define UNITYDELTACAST_FIELD_MODE_BOB 0u
-#define UNITYDELTACAST_FIELD_MERGE    1u
+// behavior. 2 selects the same field mode but deinterlaces motion-adaptively:
+// static picture areas keep the full vertical resolution of the previous field,
+// moving areas are bobbed (YUV422_8 packing; other packings are bobbed).
+#define UNITYDELTACAST_FIELD_MODE_BOB             0u
+#define UNITYDELTACAST_FIELD_MERGE                1u
+#define UNITYDELTACAST_FIELD_MODE_MOTION_ADAPTIVE 2u
+
+// StartCaptureMosaic layouts: rows x columns of equally sized tiles.
+#define UNITYDELTACAST_MOSAIC_1X2 0u   // 1 row of 2 (side by side)
+#define UNITYDELTACAST_MOSAIC_2X1 1u   // 2 rows of 1 (stacked)
+#define UNITYDELTACAST_MOSAIC_2X2 2u
+#define UNITYDELTACAST_MOSAIC_3X3 3u
+
+// SetOutputFormat formats of the frames StartCapture publishes.
+#define UNITYDELTACAST_OUTPUT_BGRA8  0u   // 4 bytes/pixel B,G,R,A (default); 10-bit input is dithered
+#define UNITYDELTACAST_OUTPUT_RGBA16 1u   // 8 bytes/pixel R,G,B,A as uint16 (Unity TextureFormat.RGBA64)
+#define UNITYDELTACAST_OUTPUT_UYVY8  2u   // unconverted 8-bit U,Y0,V,Y1 payload, top row first
+
+// SetColorMatrix YCbCr -> RGB matrices. AUTO follows the signal: the colorimetry
+// a DV signal reports, otherwise BT.601 for SD and BT.709 for HD and above.
+#define UNITYDELTACAST_COLOR_MATRIX_AUTO           0u   // default
+#define UNITYDELTACAST_COLOR_MATRIX_BT601_LIMITED  1u   // Y 16..235, CbCr 16..240
+#define UNITYDELTACAST_COLOR_MATRIX_BT601_FULL     2u   // Y, CbCr 0..255
+#define UNITYDELTACAST_COLOR_MATRIX_BT709_LIMITED  3u
+#define UNITYDELTACAST_COLOR_MATRIX_BT709_FULL     4u
+#define UNITYDELTACAST_COLOR_MATRIX_BT2020_LIMITED 5u   // non-constant luminance
+#define UNITYDELTACAST_COLOR_MATRIX_BT2020_FULL    6u
+
+// SetSlotQueuePolicy policies: what the slot drain thread does when the queue to
+// the conversion thread is full.
+#define UNITYDELTACAST_SLOT_QUEUE_DROP_OLDEST 0u   // release the oldest queued slot unconverted
+#define UNITYDELTACAST_SLOT_QUEUE_BLOCK       1u   // stop draining; the board queue absorbs (and drops)
+
+// SetConversionMode modes: when a StartCapture stream converts its slots.
+#define UNITYDELTACAST_CONVERSION_EAGER     0u   // every captured slot, as it arrives (default)
+#define UNITYDELTACAST_CONVERSION_ON_DEMAND 1u   // the newest slot, when a consumer asks for a frame
+
+// SetLatencyMode modes: which board slot a StartCapture stream converts next.
+#define UNITYDELTACAST_LATENCY_QUEUED 0u   // the oldest filled slot, every slot in turn (default)
+#define UNITYDELTACAST_LATENCY_NEWEST 1u   // the newest filled slot; older ones are released unconverted
+
+// StartRecording pixel formats piped to ffmpeg.
+#define UNITYDELTACAST_RECORD_BGRA 0u   // the published BGRA frames (4 bytes/pixel, see applyVFlip)
+#define UNITYDELTACAST_RECORD_UYVY 1u   // captured 4:2:2 as uyvy422 (2 bytes/pixel), top row first
+#define UNITYDELTACAST_RECORD_NV12 2u   // 4:2:0 nv12 (1.5 bytes/pixel), top row first
+
+// GetStreamStats snapshot of one stream, counted since its capture started.
+typedef struct StreamStats {
+    unsigned long long capturedFrames;      // slots popped from the board
+    unsigned long long publishedFrames;     // frames converted and published
+    unsigned long long consumedFrames;      // distinct frames read by GetFrame, GetFrameIfNewer or AcquireFrame
+    unsigned int boardSlotsCount;           // filled slots still on the board after the last pop
+    unsigned long long boardSlotsDropped;   // slots the board dropped (StartCapture streams)
+    double conversionP50Ms;                 // conversion wall time per frame, 0.25 ms buckets
+    double conversionP99Ms;
+    double conversionMaxMs;
+    double publishToFetchMs;                // publish to first fetch, exponentially averaged
+    int recorderBacklog;                    // frame periods the recorder runs behind its schedule
+    unsigned long long recorderGapFills;    // recorded frames repeated because no new one arrived
+    double captureThreadCpuMs;              // CPU time of the stream's capture thread
+    double conversionThreadCpuMs;           // and of its conversion thread (StartCapture; the
+                                            // shared conversion pool workers are not included)
+} StreamStats;
 
 // C API: functions must be extern "C" to avoid C++ name mangling
 extern "C" {
@@ -23,21 +85,229 @@ UNITYDLL_EXPORT void InitLibrary();
 // Example: add two numbers
 UNITYDLL_EXPORT int AddInts(int a, int b);
 
-// Example: pass a string back to Unity (caller copies it!)
+// The log lines written since the last call, one per line (caller copies it!).
+// Log calls only queue a record; the lines are formatted here.
 UNITYDLL_EXPORT const char* GetMessage();
 
 // Copy a human-readable signal/video description for stream `index` into `buffer`
 // (ANSI, null-terminated, truncated to bufferSize). Consumed by Unity's DeltacastAdapter.
 UNITYDLL_EXPORT void GetSignalAndVideoInfo(int index, char* buffer, int bufferSize);
 
+// Copy the latest frame of stream `index` only if it is newer than `lastSeen`
+// (a frame number previously returned here, by AcquireFrame or GetNativeFrameCounter;
+// pass 0 after (re)starting a capture). Returns the number of bytes copied, or 0 when
+// no newer frame has been published. *seqOut receives the copied frame's number, or
+// `lastSeen` if nothing was copied.
+UNITYDLL_EXPORT int GetFrameIfNewer(int index, uint8_t* dst, int maxSize,
+                                    unsigned long long lastSeen, unsigned long long* seqOut);
+
+// ---- Zero-copy frame access ----
+// Lend the latest published frame of stream `index` to the caller without copying.
+// On success returns 1 and sets *data to a read-only pointer into the plugin's frame
+// pool, *size to its length in bytes and *seq to its frame number (the value
+// GetNativeFrameCounter reported when it was published). The buffer stays valid and
+// unmodified until ReleaseFrame(index, *seq); the capture thread keeps publishing into
+// other buffers meanwhile. Returns 0 (and null/0 outputs) if no frame is available.
+// Every successful AcquireFrame must be paired with exactly one ReleaseFrame.
+UNITYDLL_EXPORT int AcquireFrame(int index, const uint8_t** data, int* size, unsigned long long* seq);
+UNITYDLL_EXPORT void ReleaseFrame(int index, unsigned long long seq);
+
+// Benchmark the UYVY->BGRA conversion kernels on a synthetic width x height frame
+// (`iterations` passes per kernel). Every kernel the CPU supports is timed and
+// checked bit-exact against the scalar reference; the report (Mpixels/s per path
+// and the path selected at runtime) is copied into `buffer` (ANSI, null-terminated,
+// truncated to bufferSize) and also appended to GetMessage(). Returns the report length.
+UNITYDLL_EXPORT int RunConversionBenchmark(int width, int height, int iterations, char* buffer, int bufferSize);
+
+// Benchmark per-row against per-frame dispatch of the 4:2:2 conversion for a
+// width x height frame over `iterations` frames: packing, format and flip decided
+// on every row (as before) against the kernel specialized for them and resolved
+// once per frame, for UYVY8 and YUV422_10 to BGRA8/RGBA16, with an exactness
+// check. Report handling as RunConversionBenchmark.
+UNITYDLL_EXPORT int RunDispatchBenchmark(int width, int height, int iterations, char* buffer, int bufferSize);
+
+// Check and benchmark every UNITYDELTACAST_COLOR_MATRIX_* matrix on a synthetic
+// width x height frame over `iterations` frames: the largest and mean error of
+// the selected kernel against the exact equations over all 8-bit codes, the
+// throughput relative to BT.601 limited, and the SIMD kernels checked bit-exact
+// against the scalar reference. Report handling as RunConversionBenchmark.
+UNITYDLL_EXPORT int RunColorMatrixBenchmark(int width, int height, int iterations, char* buffer, int bufferSize);
+
+// Benchmark field-mode bob deinterlacing of a width x height frame (1920 x 1080 for
+// 1080i50) over `iterations` fields: the fused single pass against the previous
+// convert-then-interpolate passes, with an exactness check between the two, and
+// the motion-adaptive field mode, per field in ms and as a share of the 20 ms
+// field period. Report handling as
+// RunConversionBenchmark.
+UNITYDLL_EXPORT int RunFieldBobBenchmark(int width, int height, int iterations, char* buffer, int bufferSize);
+
+// ---- Mosaic capture ----
+// Captures `inputCount` inputs (deviceIds[i], rxStreamIds[i]) and publishes them
+// as one BGRA8 frame on stream `index`, so Unity uploads a single texture. Tile i
+// sits at row i / columns, column i % columns of the layout (UNITYDELTACAST_MOSAIC_*),
+// tile 0 top-left; extra inputs are ignored, and tiles without an input are
+// cleared to black on every compose. Each tile is tileWidth x tileHeight (<= 0:
+// the mosaic is 1920x1080) and every input is converted straight into its tile,
+// box-downscaled when larger, all inputs in one conversion pool batch. Inputs are
+// captured as YUV422_8 merged frames with their format detected; a new mosaic
+// frame is composed whenever any input delivers one, and a tile keeps its last
+// picture while its input has no new frame.
+// Stopped with StopCapture(index).
+UNITYDLL_EXPORT void StartCaptureMosaic(int index, const int* deviceIds, const int* rxStreamIds, int inputCount,
+                                        unsigned int layout, int tileWidth, int tileHeight, int buffer_depth);
+
+// ---- Signal monitoring ----
+// Each capture session polls signal presence and format on a monitor thread
+// every `intervalMs` (default 100; <= 0 restores it) instead of once per frame;
+// a change is picked up within one interval. Takes effect at the next StartCapture.
+UNITYDLL_EXPORT void SetSignalPollInterval(int intervalMs);
+
+// Benchmark the capture loop's signal-check overhead, per-frame SDK probing vs the
+// monitor thread, for `frames` loop iterations paced at 60 Hz (600 take 10 s)
+// against a stand-in board whose property reads cost `probeCostUs` each. Report
+// handling as RunConversionBenchmark.
+UNITYDLL_EXPORT int RunSignalMonitorBenchmark(int frames, int probeCostUs, int pollIntervalMs,
+                                              char* buffer, int bufferSize);
+
+// Benchmark one log call, the record ring against the former string-building
+// log, from 1 and 4 threads (`iterations` calls each). Report handling as
+// RunConversionBenchmark.
+UNITYDLL_EXPORT int RunLoggingBenchmark(int iterations, char* buffer, int bufferSize);
+
+// ---- Pipeline trace ----
+// While tracing is on, every stage (pop_slot, convert, burn_in, publish,
+// record_feed, the recorder's copy and pipe write, compose, and the consumer's
+// GetFrame / GetFrameIfNewer / AcquireFrame) is recorded with its thread, begin
+// and end time and frame number into per-thread preallocated rings that keep the
+// most recent 16384 events per thread. Off by default; turning it on starts a new
+// trace. A disabled stage costs one relaxed atomic load.
+UNITYDLL_EXPORT void SetTracing(int enabled);
+
+// Write the current trace to `path` as Chrome trace JSON (chrome://tracing,
+// ui.perfetto.dev). Tracing may stay on. Returns the number of events written,
+// or -1 if the file cannot be written.
+UNITYDLL_EXPORT int DumpTrace(const char* path);
+
+// ---- Conversion worker pool (shared by all capture streams) ----
+// Frame conversion is split into horizontal bands that run in parallel on a
+// persistent per-process pool. `threads` is the total number of threads working
+// on one frame (the capture thread included); 1 converts serially, <= 0 restores
+// the default (hardware concurrency, at most 8). Takes effect immediately.
+UNITYDLL_EXPORT void SetConversionThreads(int threads);
+UNITYDLL_EXPORT int GetConversionThreads();
+
+// Average per-frame conversion time for stream `index`, in milliseconds.
+//   wallMs   : latency the capture thread actually spent converting a frame
+//   serialMs : summed time of all bands, i.e. the single-threaded cost
+// serialMs - wallMs is the latency the pool removes from every frame.
+UNITYDLL_EXPORT void GetConversionTiming(int index, double* wallMs, double* serialMs);
+
+// ---- Source packing / output format ----
+// StartCapture converts the buffer_packing it was given: YUV422_8, YUV422_10 (V210),
+// YUV422_10_NOPAD_BIGEND and YUV422_16 are supported; any other packing is
+// converted as YUV422_8 as before. SetOutputFormat selects what stream `index`
+// publishes from the next frame on (UNITYDELTACAST_OUTPUT_*). RGBA16 keeps the
+// full 10-bit precision; frame-number burn-in and recording need BGRA8.
+// UYVY8 skips the CPU conversion and publishes the slot payload as captured
+// (2 bytes/pixel, rows may be padded), for conversion in a shader; it applies
+// to YUV422_8 captures only, other packings keep publishing BGRA8.
+// DV signals whose cable colour space is RGB are captured as RGB_24 whatever
+// buffer_packing was given (RGB_24 and RGB_32 are also honored when requested)
+// and reordered to BGRA8 without a YCbCr matrix: lossless for full-range RGB,
+// limited-range RGB is expanded to 0..255. They always publish BGRA8.
+UNITYDLL_EXPORT void SetOutputFormat(int index, unsigned int format);
+
+// Selects the YCbCr -> RGB matrix (UNITYDELTACAST_COLOR_MATRIX_*) stream `index`
+// converts with from the next frame on; AUTO (the default) follows the signal.
+// Also applies to the stereo and mosaic outputs published to `index`.
+// GetColorMatrix returns the matrix the latest published frame was converted
+// with (for a mosaic, that of its first input), 0 before any frame has been
+// converted and for RGB captures.
+UNITYDLL_EXPORT void SetColorMatrix(int index, unsigned int matrix);
+UNITYDLL_EXPORT unsigned int GetColorMatrix(int index);
+
+// Describes the latest published frame of stream `index`: format
+// (UNITYDELTACAST_OUTPUT_*), row pitch in bytes and size in pixels. Returns 0
+// if no frame has been published yet. The frame data is pitch * h bytes; the
+// converted formats are stored bottom row first, UYVY8 top row first.
+UNITYDLL_EXPORT int GetFrameFormat(int index, unsigned int* format, int* pitch, int* w, int* h);
+
+// ---- Slot drain / conversion pipeline ----
+// StartCapture pops slots from the board on the capture thread and hands them to
+// a per-stream conversion thread through a bounded queue of `capacity` slots
+// (default 2, at most 64). Queued slots are held by the plugin, so keep
+// capacity below the capture buffer_depth. Takes effect at the next StartCapture.
+UNITYDLL_EXPORT void SetSlotQueuePolicy(int index, unsigned int policy, int capacity);
+
+// Per-stage counters for stream `index` (any pointer may be null):
+//   occupancy/capacity : slots currently queued for conversion / queue size
+//   queueDropped       : slots released unconverted by DROP_OLDEST
+//   boardDropped       : slots the board dropped because the drain fell behind
+//   publishDropped     : frames not published because every frame buffer was in use
+//                        (a UYVY/NV12 recording still receives them)
+UNITYDLL_EXPORT void GetSlotQueueCounters(int index, int* occupancy, int* capacity,
+                                          unsigned long long* queueDropped,
+                                          unsigned long long* boardDropped,
+                                          unsigned long long* publishDropped);
+
+// Selects when stream `index` converts (UNITYDELTACAST_CONVERSION_*); takes
+// effect from the next slot. ON_DEMAND keeps draining the board and keeps only
+// the newest slot unconverted; GetFrame, GetFrameIfNewer, AcquireFrame and
+// GetFrameFormat convert it on the calling thread the first time any of them
+// is called for it, and every later call reads the converted frame. Streams
+// nobody reads from therefore cost no conversion. GetNativeFrameCounter still
+// advances per captured frame. While a recording runs the stream converts
+// eagerly. StartCapture streams only (not stereo or mosaic).
+UNITYDLL_EXPORT void SetConversionMode(int index, unsigned int mode);
+
+// ON_DEMAND counters since StartCapture: slots converted for a consumer, and
+// slots released unconverted because a newer one arrived first.
+UNITYDLL_EXPORT void GetOnDemandCounters(int index, unsigned long long* converted, unsigned long long* skipped);
+
+// Selects the latency mode of stream `index` (UNITYDELTACAST_LATENCY_*); takes
+// effect at the next StartCapture. NEWEST drains the board queue on every pop
+// and converts only the most recent slot, with a conversion queue of one slot
+// under DROP_OLDEST (SetSlotQueuePolicy is ignored), so a consumer that falls
+// behind sees the live picture instead of one up to buffer_depth slots old.
+UNITYDLL_EXPORT void SetLatencyMode(int index, unsigned int mode);
+
+// Capture-to-publish age of stream `index` since StartCapture (any pointer may
+// be null): the latest published frame and an exponential average, in ms, and
+// the slots NEWEST released unconverted. The board does not timestamp slots, so
+// the capture time is the pop time less one slot period per slot still queued
+// on the board behind it. In the ON_DEMAND conversion mode the age includes the
+// wait for a consumer.
+UNITYDLL_EXPORT void GetFrameAge(int index, double* lastMs, double* averageMs, unsigned long long* drainedSlots);
+
+// Stage times of published frame `seq` of a StartCapture stream, in ms after
+// its capture time (see GetFrameAge): popped from the board, converted,
+// published, and first fetched through GetFrame, GetFrameIfNewer or
+// AcquireFrame (any pointer may be null; -1 for a stage not reached yet).
+// The last 256 frames are kept; returns 0 for an older or unknown frame.
+UNITYDLL_EXPORT int GetFrameTiming(int index, unsigned long long seq, double* popMs, double* convertMs,
+                                   double* publishMs, double* fetchMs);
+
+// Median and 99th percentile, in ms, of capture-to-publish and capture-to-fetch
+// over those last 256 frames. Returns how many frames the publish figures cover.
+UNITYDLL_EXPORT int GetLatencyStats(int index, double* publishP50, double* publishP99,
+                                    double* fetchP50, double* fetchP99);
+
+// Fills `stats` for stream `index`; returns 0 (and zeroes it) for an invalid
+// index. Every figure is read from counters the pipeline keeps with relaxed
+// atomics, so polling it every frame costs the capture path nothing.
+UNITYDLL_EXPORT int GetStreamStats(int index, StreamStats* stats);
+
 // ---- Recording API (offloaded ffmpeg recording, see unityDeltacast.cpp) ----
-// Start recording the BGRA frames currently being captured/published for `index`.
-//   ffmpegExe      : "ffmpeg" (on PATH) or a full path to ffmpeg.exe
+// Start recording the frames currently being captured/published for `index`.
+//   ffmpegExe      : "ffmpeg" (on PATH) or a full path to ffmpeg(.exe)
 //   outputPattern  : segment output pattern, e.g. "C:\\rec\\Stream0_Video_part_%03d.mov"
 //   fps            : constant output frame rate (e.g. 30 or 50)
 //   segmentSeconds : seconds per segment (e.g. 60 -> exactly fps*60 frames per file)
 //   encoderArgs    : optional encoder portion of the ffmpeg command; null/empty -> built-in default
-//   applyVFlip     : 1 -> add "-vf vflip" (the published buffer is vertically flipped)
+//   applyVFlip     : 1 -> add "-vf vflip" (the published buffer is vertically flipped); BGRA only
+//   pixelFormat    : UNITYDELTACAST_RECORD_*. UYVY and NV12 are produced by the conversion
+//                    thread from the captured slot and need a YUV422_8 StartCapture; BGRA
+//                    needs SetOutputFormat(index, UNITYDELTACAST_OUTPUT_BGRA8).
 // Returns 1 on success (writer thread started), 0 on failure / already recording.
 UNITYDLL_EXPORT int StartRecording(int index,
                                    const char* ffmpegExe,
@@ -45,7 +315,16 @@ UNITYDLL_EXPORT int StartRecording(int index,
                                    int fps,
                                    int segmentSeconds,
                                    const char* encoderArgs,
-                                   int applyVFlip);
+                                   int applyVFlip,
+                                   unsigned int pixelFormat);
+
+// Like StartRecording, but pipes the raw frames (pixelFormat, fps-paced, gap-filled)
+// to `commandLine` instead of ffmpeg: any program reading them from stdin, e.g.
+// "cat > /tmp/stream0.uyvy" or a custom encoder. POSIX runs it with /bin/sh -c;
+// Windows starts it with CreateProcess (use "cmd /c ..." for redirections). Its
+// output is discarded. BGRA frames are piped as published, bottom row first.
+// Returns 1 on success (writer thread started), 0 on failure / already recording.
+UNITYDLL_EXPORT int StartRecordingPipe(int index, const char* commandLine, int fps, unsigned int pixelFormat);
 
 // Stop recording for `index`: closes ffmpeg's stdin (finalizing the last segment),
 // waits for ffmpeg to exit, and joins the writer thread.